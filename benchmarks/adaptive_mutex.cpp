@@ -0,0 +1,57 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+#include <felly/adaptive_mutex.hpp>
+#include <felly/guarded_data.hpp>
+
+#include <cstdint>
+#include <format>
+#include <mutex>
+
+#include "threads.hpp"
+
+namespace {
+
+template <class TMutex>
+std::uint64_t contend(
+  const std::size_t threadCount,
+  const std::size_t criticalSectionLength) {
+  felly::guarded_data<std::uint64_t, TMutex> counter {std::uint64_t {0}};
+  felly_benchmarks::in_threads(threadCount, [&] {
+    auto lock = counter.lock();
+    for (std::size_t k = 0; k < criticalSectionLength; ++k) {
+      // Stop the compiler collapsing the loop into a single addition
+      Catch::Benchmark::keep_memory(&lock.get());
+      ++*lock;
+    }
+  });
+  return *counter.lock();
+}
+
+}// namespace
+
+// The crossover point is where `adaptive_mutex` stops being faster than
+// `std::mutex`; this is expected to be with longer critical sections and with
+// more threads than cores.
+TEMPLATE_TEST_CASE(
+  "adaptive_mutex vs std::mutex",
+  "[adaptive_mutex]",
+  std::mutex,
+  felly::adaptive_mutex) {
+  const auto threadCount
+    = GENERATE(from_range(felly_benchmarks::ThreadCounts));
+  const auto criticalSectionLength
+    = GENERATE(as<std::size_t> {}, 1, 16, 256, 4096);
+
+  BENCHMARK(
+    std::format(
+      "{} threads, {} increments per lock",
+      threadCount,
+      criticalSectionLength)) {
+    return contend<TestType>(threadCount, criticalSectionLength);
+  };
+}
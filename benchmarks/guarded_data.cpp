@@ -0,0 +1,50 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+#include <felly/guarded_data.hpp>
+
+#include <cstdint>
+#include <format>
+#include <mutex>
+
+#include "threads.hpp"
+
+namespace {
+
+using felly_benchmarks::in_threads;
+
+std::uint64_t guarded(const std::size_t threadCount) {
+  felly::guarded_data<std::uint64_t> counter {std::uint64_t {0}};
+  in_threads(threadCount, [&] { ++*counter.lock(); });
+  return *counter.lock();
+}
+
+std::uint64_t manual(const std::size_t threadCount) {
+  std::mutex mutex;
+  std::uint64_t counter {0};
+  in_threads(threadCount, [&] {
+    const std::unique_lock lock {mutex};
+    ++counter;
+  });
+  const std::unique_lock lock {mutex};
+  return counter;
+}
+
+}// namespace
+
+// These are expected to be indistinguishable
+TEST_CASE("guarded_data vs std::mutex", "[guarded_data]") {
+  const auto threadCount
+    = GENERATE(from_range(felly_benchmarks::ThreadCounts));
+
+  BENCHMARK(std::format("guarded_data, {} threads", threadCount)) {
+    return guarded(threadCount);
+  };
+  BENCHMARK(std::format("std::mutex, {} threads", threadCount)) {
+    return manual(threadCount);
+  };
+}
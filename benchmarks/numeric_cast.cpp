@@ -0,0 +1,58 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <felly/numeric_cast.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+template <class From>
+std::vector<From> make_values() {
+  std::vector<From> values(1000);
+  std::iota(values.begin(), values.end(), From {});
+  return values;
+}
+
+}// namespace
+
+// `numeric_cast()` is expected to cost a comparison or two per value more than
+// `static_cast`; the error path is out of line, so should not affect this.
+TEST_CASE("numeric_cast vs static_cast", "[numeric_cast]") {
+  const auto integers = make_values<std::int64_t>();
+  const auto doubles = make_values<double>();
+
+  BENCHMARK("static_cast<int32_t>(int64_t)") {
+    std::int32_t sum {};
+    for (auto value: integers) {
+      sum += static_cast<std::int32_t>(value);
+    }
+    return sum;
+  };
+  BENCHMARK("numeric_cast<int32_t>(int64_t)") {
+    std::int32_t sum {};
+    for (auto value: integers) {
+      sum += felly::numeric_cast<std::int32_t>(value);
+    }
+    return sum;
+  };
+
+  BENCHMARK("static_cast<int32_t>(double)") {
+    std::int32_t sum {};
+    for (auto value: doubles) {
+      sum += static_cast<std::int32_t>(value);
+    }
+    return sum;
+  };
+  BENCHMARK("numeric_cast<int32_t>(double)") {
+    std::int32_t sum {};
+    for (auto value: doubles) {
+      sum += felly::numeric_cast<std::int32_t>(value);
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/generators/catch_generators_range.hpp>
+#include <felly/guarded_data.hpp>
+#include <felly/per_thread.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <format>
+
+#include "threads.hpp"
+
+namespace {
+
+using felly_benchmarks::in_threads;
+
+std::uint64_t guarded(const std::size_t threadCount) {
+  felly::guarded_data<std::uint64_t> counter {std::uint64_t {0}};
+  in_threads(threadCount, [&] { ++*counter.lock(); });
+  return *counter.lock();
+}
+
+using counter_type = felly::per_thread<std::atomic<std::uint64_t>>;
+
+std::uint64_t total(const counter_type& counter) {
+  return counter.reduce(
+    std::uint64_t {0},
+    [](const std::uint64_t acc, const std::atomic<std::uint64_t>& value) {
+      return acc + value.load(std::memory_order_relaxed);
+    });
+}
+
+std::uint64_t per_thread(const std::size_t threadCount) {
+  counter_type counter;
+  in_threads(threadCount, [&] {
+    counter.local().fetch_add(1, std::memory_order_relaxed);
+  });
+  return total(counter);
+}
+
+std::uint64_t twice(const std::size_t threadCount) {
+  counter_type counter;
+  in_threads(threadCount, [&] {
+    counter.local().fetch_add(1, std::memory_order_relaxed);
+    counter.local().fetch_add(1, std::memory_order_relaxed);
+  });
+  return total(counter);
+}
+
+std::uint64_t interleaved(const std::size_t threadCount) {
+  counter_type a;
+  counter_type b;
+  in_threads(threadCount, [&] {
+    a.local().fetch_add(1, std::memory_order_relaxed);
+    b.local().fetch_add(1, std::memory_order_relaxed);
+  });
+  return total(a) + total(b);
+}
+
+}// namespace
+
+// `per_thread` is expected to scale with the thread count, as threads do not
+// share a mutex or a cache line
+TEST_CASE("per_thread vs guarded_data", "[per_thread]") {
+  const auto threadCount
+    = GENERATE(from_range(felly_benchmarks::ThreadCounts));
+
+  BENCHMARK(std::format("guarded_data, {} threads", threadCount)) {
+    return guarded(threadCount);
+  };
+  BENCHMARK(std::format("per_thread, {} threads", threadCount)) {
+    return per_thread(threadCount);
+  };
+}
+
+// These are expected to be indistinguishable, as each thread remembers its
+// slots for several recently used `per_thread`s
+TEST_CASE("per_thread - interleaved instances", "[per_thread]") {
+  const auto threadCount
+    = GENERATE(from_range(felly_benchmarks::ThreadCounts));
+
+  BENCHMARK(std::format("one instance twice, {} threads", threadCount)) {
+    return twice(threadCount);
+  };
+  BENCHMARK(std::format("two instances, {} threads", threadCount)) {
+    return interleaved(threadCount);
+  };
+}
@@ -0,0 +1,79 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <felly/scope_exit.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t Iterations = 1000;
+
+std::uint64_t cleanups {0};
+
+void cleanup(const std::size_t i) noexcept {
+  cleanups += i;
+}
+
+}// namespace
+
+TEST_CASE("scope_exit vs manual cleanup", "[scope_exit]") {
+  BENCHMARK("manual") {
+    for (std::size_t i = 0; i < Iterations; ++i) {
+      Catch::Benchmark::keep_memory(&i);
+      cleanup(i);
+    }
+    return cleanups;
+  };
+
+  BENCHMARK("scope_exit") {
+    for (std::size_t i = 0; i < Iterations; ++i) {
+      const felly::scope_exit guard {[i] { cleanup(i); }};
+      Catch::Benchmark::keep_memory(&i);
+    }
+    return cleanups;
+  };
+
+  BENCHMARK("scope_success") {
+    for (std::size_t i = 0; i < Iterations; ++i) {
+      const felly::scope_success guard {[i] { cleanup(i); }};
+      Catch::Benchmark::keep_memory(&i);
+    }
+    return cleanups;
+  };
+}
+
+TEST_CASE(
+  "scope_exit_stack vs std::vector<std::function>",
+  "[scope_exit]") {
+  constexpr std::size_t CallbacksPerScope = 8;
+
+  BENCHMARK("std::vector<std::function>") {
+    for (std::size_t i = 0; i < Iterations; ++i) {
+      std::vector<std::function<void()>> callbacks;
+      for (std::size_t j = 0; j < CallbacksPerScope; ++j) {
+        callbacks.emplace_back([j] { cleanup(j); });
+      }
+      while (!callbacks.empty()) {
+        callbacks.back()();
+        callbacks.pop_back();
+      }
+    }
+    return cleanups;
+  };
+
+  BENCHMARK("scope_exit_stack") {
+    for (std::size_t i = 0; i < Iterations; ++i) {
+      felly::scope_exit_stack<CallbacksPerScope> callbacks;
+      for (std::size_t j = 0; j < CallbacksPerScope; ++j) {
+        callbacks.push([j] { cleanup(j); });
+      }
+    }
+    return cleanups;
+  };
+}
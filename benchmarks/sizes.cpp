@@ -0,0 +1,85 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+// Object size regression checks: each component should be no larger than the
+// hand-written equivalent. These are checked when the `benchmarks` target is
+// built, rather than at runtime.
+
+#include <felly/guarded_data.hpp>
+#include <felly/object_pool.hpp>
+#include <felly/retain_ptr.hpp>
+#include <felly/scope_exit.hpp>
+#include <felly/unique_any.hpp>
+#include <felly/unique_ptr.hpp>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+
+namespace {
+
+struct object {
+  int value {};
+};
+
+void close_handle(int) noexcept {}
+void free_object(object*) noexcept {}
+void add_ref(object*) noexcept {}
+
+struct manual_guarded_int {
+  std::mutex mutex;
+  int value;
+};
+
+struct manual_lock {
+  std::unique_lock<std::mutex> lock;
+  int* value;
+};
+
+struct manual_scope_guard {
+  int* captured;
+  bool owned;
+};
+
+struct manual_scope_success_guard {
+  int initialUncaught;
+  int* captured;
+  bool owned;
+};
+
+int captured {};
+constexpr auto callback = [p = &captured] { ++*p; };
+using callback_type = std::remove_const_t<decltype(callback)>;
+
+}// namespace
+
+static_assert(
+  sizeof(felly::guarded_data<int>) == sizeof(manual_guarded_int));
+static_assert(
+  sizeof(felly::unique_guarded_data_lock<int, std::mutex>)
+  == sizeof(manual_lock));
+
+static_assert(
+  sizeof(felly::unique_any<int, &close_handle>) == sizeof(std::optional<int>));
+static_assert(
+  sizeof(felly::unique_any_with_sentinel<int, &close_handle, -1>)
+  == sizeof(int));
+static_assert(
+  sizeof(felly::unique_ptr<object, &free_object>) == sizeof(object*));
+static_assert(
+  sizeof(felly::unique_ptr<object, std::default_delete<object> {}>)
+  == sizeof(std::unique_ptr<object>));
+static_assert(sizeof(felly::pooled_ptr<object>) == sizeof(object*));
+static_assert(
+  sizeof(felly::retain_ptr<object, &add_ref, &free_object>)
+  == sizeof(object*));
+
+static_assert(
+  sizeof(felly::scope_exit<callback_type>) == sizeof(manual_scope_guard));
+static_assert(
+  sizeof(felly::scope_fail<callback_type>)
+  == sizeof(manual_scope_success_guard));
+static_assert(
+  sizeof(felly::scope_success<callback_type>)
+  == sizeof(manual_scope_success_guard));
@@ -0,0 +1,34 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace felly_benchmarks {
+
+// For contended benchmarks, e.g. `GENERATE(from_range(ThreadCounts))`
+inline constexpr std::array<std::size_t, 7> ThreadCounts {
+  1, 2, 4, 8, 16, 32, 64};
+
+// Enough that thread creation is not a significant part of the measurement
+inline constexpr std::size_t IterationsPerThread = 10000;
+
+// Calls `f()` `IterationsPerThread` times in each of `threadCount` threads,
+// and waits for them to finish
+template <class F>
+void in_threads(const std::size_t threadCount, F&& f) {
+  std::vector<std::jthread> threads;
+  threads.reserve(threadCount);
+  for (std::size_t i = 0; i < threadCount; ++i) {
+    threads.emplace_back([&f] {
+      for (std::size_t j = 0; j < IterationsPerThread; ++j) {
+        f();
+      }
+    });
+  }
+}
+
+}// namespace felly_benchmarks
@@ -0,0 +1,86 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <felly/unique_any.hpp>
+#include <felly/unique_ptr.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t HandleCount = 1000;
+
+// A stand-in for an OS handle API; the benchmark is measuring the overhead
+// of the wrappers, not the cost of a real `close()`
+std::uint64_t closed_handles {0};
+
+int open_handle(const int i) noexcept {
+  return i;
+}
+
+void close_handle(const int handle) noexcept {
+  closed_handles += handle;
+}
+
+struct object {
+  int value {};
+};
+
+void free_object(object* p) noexcept {
+  delete p;
+}
+
+}// namespace
+
+TEST_CASE("unique_any vs raw handles", "[unique_any]") {
+  BENCHMARK("raw") {
+    for (std::size_t i = 0; i < HandleCount; ++i) {
+      const auto handle = open_handle(static_cast<int>(i));
+      Catch::Benchmark::keep_memory(&handle);
+      close_handle(handle);
+    }
+    return closed_handles;
+  };
+
+  BENCHMARK("unique_any") {
+    for (std::size_t i = 0; i < HandleCount; ++i) {
+      const felly::unique_any<int, &close_handle> handle {
+        open_handle(static_cast<int>(i))};
+      Catch::Benchmark::keep_memory(&handle);
+    }
+    return closed_handles;
+  };
+}
+
+TEST_CASE("unique_ptr vs raw pointers", "[unique_ptr]") {
+  BENCHMARK("raw") {
+    std::vector<object*> objects;
+    objects.reserve(HandleCount);
+    for (std::size_t i = 0; i < HandleCount; ++i) {
+      objects.push_back(new object {static_cast<int>(i)});
+    }
+    for (auto p: objects) {
+      free_object(p);
+    }
+  };
+
+  BENCHMARK("felly::unique_ptr") {
+    std::vector<felly::unique_ptr<object, &free_object>> objects;
+    objects.reserve(HandleCount);
+    for (std::size_t i = 0; i < HandleCount; ++i) {
+      objects.emplace_back(new object {static_cast<int>(i)});
+    }
+  };
+
+  BENCHMARK("std::unique_ptr") {
+    std::vector<std::unique_ptr<object>> objects;
+    objects.reserve(HandleCount);
+    for (std::size_t i = 0; i < HandleCount; ++i) {
+      objects.emplace_back(new object {static_cast<int>(i)});
+    }
+  };
+}
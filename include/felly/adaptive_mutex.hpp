@@ -0,0 +1,110 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) \
+  && (defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+namespace felly_detail {
+
+inline void cpu_relax() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+  __yield();
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+}// namespace felly_detail
+
+namespace felly::inline adaptive_mutex_types {
+
+/** A mutex that spins for a short time before sleeping.
+ *
+ * This is intended for very short critical sections, where the cost of
+ * sleeping and waking is much higher than the cost of the critical section.
+ *
+ * When contended, `lock()` checks the lock `TMaxSpins` times, with an
+ * exponential backoff of CPU pause/yield instructions between each check; if
+ * it is still locked, the thread sleeps via `std::atomic::wait()`, which is a
+ * futex or similar (e.g. `WaitOnAddress()`) on major platforms.
+ *
+ * The entire state is a single 32-bit atomic.
+ */
+template <std::uint32_t TMaxSpins = 64>
+class basic_adaptive_mutex {
+ public:
+  constexpr basic_adaptive_mutex() noexcept = default;
+  basic_adaptive_mutex(const basic_adaptive_mutex&) = delete;
+  basic_adaptive_mutex& operator=(const basic_adaptive_mutex&) = delete;
+
+  void lock() noexcept {
+    if (try_lock()) [[likely]] {
+      return;
+    }
+    lock_slow();
+  }
+
+  [[nodiscard]]
+  bool try_lock() noexcept {
+    std::uint32_t expected = Unlocked;
+    return mState.compare_exchange_strong(
+      expected, Locked, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept {
+    if (mState.exchange(Unlocked, std::memory_order_release) == Contended)
+      [[unlikely]] {
+      mState.notify_one();
+    }
+  }
+
+ private:
+  enum state : std::uint32_t {
+    Unlocked,
+    Locked,
+    // Locked, and there may be sleeping waiters
+    Contended,
+  };
+  std::atomic<std::uint32_t> mState {Unlocked};
+
+  void lock_slow() noexcept {
+    // Longest backoff is 2^MaxBackoffShift pause instructions; this is
+    // roughly a microsecond on modern x86
+    constexpr std::uint32_t MaxBackoffShift = 6;
+    for (std::uint32_t i = 0; i < TMaxSpins; ++i) {
+      const auto pauses = std::uint32_t {1} << std::min(i, MaxBackoffShift);
+      for (std::uint32_t j = 0; j < pauses; ++j) {
+        felly_detail::cpu_relax();
+      }
+      // Read before writing, so the cache line stays shared while locked
+      if (mState.load(std::memory_order_relaxed) == Unlocked && try_lock()) {
+        return;
+      }
+    }
+
+    // We can't tell if there are other waiters, so we must conservatively mark
+    // it as contended when we acquire it, so `unlock()` wakes the next waiter
+    while (mState.exchange(Contended, std::memory_order_acquire) != Unlocked) {
+      mState.wait(Contended, std::memory_order_relaxed);
+    }
+  }
+};
+
+using adaptive_mutex = basic_adaptive_mutex<>;
+static_assert(sizeof(adaptive_mutex) == sizeof(std::uint32_t));
+
+}// namespace felly::inline adaptive_mutex_types
@@ -0,0 +1,311 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "guarded_data.hpp"
+#include "no_unique_address.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace felly_detail {
+
+// Part of an awaiter, so stored in the coroutine frame
+struct async_mutex_waiter {
+  async_mutex_waiter* mNext {nullptr};
+  std::coroutine_handle<> mHandle;
+  // Resumes `mHandle` via the executor
+  void (*mResume)(async_mutex_waiter*) noexcept {nullptr};
+};
+
+// Waiters that were handed the lock while another waiter was being resumed
+// on this thread; they are resumed after it suspends or finishes, instead of
+// nesting, so that the stack does not grow with the length of the queue
+struct async_mutex_pending_list {
+  async_mutex_waiter* mHead {nullptr};
+  async_mutex_waiter* mTail {nullptr};
+  bool mResuming {false};
+};
+
+inline constinit thread_local async_mutex_pending_list async_mutex_pending {};
+
+inline void async_mutex_resume(async_mutex_waiter* const waiter) noexcept {
+  auto& pending = async_mutex_pending;
+  waiter->mNext = nullptr;
+  if (pending.mResuming) {
+    (pending.mTail ? pending.mTail->mNext : pending.mHead) = waiter;
+    pending.mTail = waiter;
+    return;
+  }
+
+  pending.mResuming = true;
+  waiter->mResume(waiter);
+  while (const auto next = pending.mHead) {
+    pending.mHead = next->mNext;
+    if (!pending.mHead) {
+      pending.mTail = nullptr;
+    }
+    // May destroy `next`
+    next->mResume(next);
+  }
+  pending.mResuming = false;
+}
+
+// Resumes the coroutine on the thread that unlocks the mutex
+struct async_inline_executor {
+  void operator()(const std::coroutine_handle<> handle) const noexcept {
+    handle.resume();
+  }
+};
+
+// Must not throw, as it is invoked by `unlock()`, which can not fail; the
+// lock has already been handed over to the waiter
+template <class T>
+concept async_executor = std::copy_constructible<std::decay_t<T>>
+  && std::is_nothrow_invocable_v<std::decay_t<T>&, std::coroutine_handle<>>;
+
+}// namespace felly_detail
+
+namespace felly::inline async_guarded_data_types {
+
+/** A mutex for coroutines: `co_await` suspends instead of blocking.
+ *
+ * When unlocked, the next waiter is resumed by invoking its executor with its
+ * `std::coroutine_handle<>`; by default, it is resumed immediately on the
+ * unlocking thread. The executor is stored in the awaiter, which is part of
+ * the coroutine frame, so waiting does not allocate.
+ *
+ * The entire state is a single pointer-sized atomic, plus a queue that is only
+ * accessed by the lock holder; locking and unlocking without contention is a
+ * single atomic operation each. Waiters are resumed in FIFO order.
+ *
+ * This can be used with `std::unique_lock`, but has no blocking `lock()`.
+ *
+ * Executors must be `noexcept`; an executor that can fail to schedule (e.g.
+ * because it allocates) must handle that itself, e.g. by resuming inline.
+ */
+class async_mutex {
+ public:
+  template <class TExecutor>
+  class awaiter;
+
+  async_mutex() = default;
+  async_mutex(const async_mutex&) = delete;
+  async_mutex& operator=(const async_mutex&) = delete;
+
+  ~async_mutex() = default;
+
+  [[nodiscard]]
+  bool try_lock() noexcept {
+    auto expected = Unlocked;
+    return mState.compare_exchange_strong(
+      expected,
+      LockedWithoutWaiters,
+      std::memory_order_acquire,
+      std::memory_order_relaxed);
+  }
+
+  /** Awaitable; the result is a `std::unique_lock<async_mutex>`.
+   *
+   * With the default executor, a suspended waiter is resumed inside the
+   * previous holder's `unlock()`, which does not return until the waiter
+   * next suspends or finishes. If that waiter unlocks in turn, the next
+   * waiter is resumed after it returns, instead of nesting another level
+   * deeper, so the stack depth does not grow with the length of the queue.
+   */
+  template <felly_detail::async_executor TExecutor
+              = felly_detail::async_inline_executor>
+  [[nodiscard]]
+  awaiter<std::decay_t<TExecutor>> lock_async(TExecutor&& executor = {}) {
+    return {*this, std::forward<TExecutor>(executor)};
+  }
+
+  void unlock() noexcept {
+    auto next = mQueue;
+    if (!next) {
+      auto expected = LockedWithoutWaiters;
+      if (mState.compare_exchange_strong(
+            expected,
+            Unlocked,
+            std::memory_order_release,
+            std::memory_order_relaxed)) [[likely]] {
+        return;
+      }
+      // There are new waiters; they were pushed to a stack, so reverse them
+      // to get FIFO order
+      auto it = reinterpret_cast<felly_detail::async_mutex_waiter*>(
+        mState.exchange(LockedWithoutWaiters, std::memory_order_acquire));
+      while (it) {
+        next = std::exchange(it, std::exchange(it->mNext, next));
+      }
+    }
+    // Ownership is transferred to `next`; the mutex stays locked
+    mQueue = next->mNext;
+    felly_detail::async_mutex_resume(next);
+  }
+
+ private:
+  // Otherwise, `mState` is the most recent waiter
+  static constexpr std::uintptr_t LockedWithoutWaiters = 0;
+  static constexpr std::uintptr_t Unlocked = 1;
+
+  std::atomic<std::uintptr_t> mState {Unlocked};
+  // Waiters that will be resumed before any in `mState`; only accessed by the
+  // lock holder
+  felly_detail::async_mutex_waiter* mQueue {nullptr};
+
+  // Returns false if the lock was acquired instead
+  bool enqueue(felly_detail::async_mutex_waiter* const waiter) noexcept {
+    auto state = mState.load(std::memory_order_relaxed);
+    while (true) {
+      if (state == Unlocked) {
+        if (mState.compare_exchange_weak(
+              state,
+              LockedWithoutWaiters,
+              std::memory_order_acquire,
+              std::memory_order_relaxed)) {
+          return false;
+        }
+        continue;
+      }
+      waiter->mNext = (state == LockedWithoutWaiters)
+        ? nullptr
+        : reinterpret_cast<felly_detail::async_mutex_waiter*>(state);
+      if (mState.compare_exchange_weak(
+            state,
+            reinterpret_cast<std::uintptr_t>(waiter),
+            std::memory_order_release,
+            std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+  }
+};
+
+template <class TExecutor>
+class async_mutex::awaiter : felly_detail::async_mutex_waiter {
+ public:
+  awaiter(async_mutex& mutex, TExecutor executor)
+    : mMutex(mutex),
+      mExecutor(std::move(executor)) {}
+
+  awaiter(const awaiter&) = delete;
+  awaiter& operator=(const awaiter&) = delete;
+
+  [[nodiscard]]
+  bool await_ready() noexcept {
+    return mMutex.try_lock();
+  }
+
+  bool await_suspend(const std::coroutine_handle<> handle) noexcept {
+    mHandle = handle;
+    mResume = &resume;
+    return mMutex.enqueue(this);
+  }
+
+  [[nodiscard]]
+  std::unique_lock<async_mutex> await_resume() noexcept {
+    return std::unique_lock {mMutex, std::adopt_lock};
+  }
+
+ private:
+  async_mutex& mMutex;
+  FELLY_NO_UNIQUE_ADDRESS TExecutor mExecutor;
+
+  static void resume(async_mutex_waiter* const waiter) noexcept {
+    const auto self = static_cast<awaiter*>(waiter);
+    std::invoke(self->mExecutor, self->mHandle);
+  }
+};
+
+/** Like `guarded_data`, but for use from coroutines.
+ *
+ * `co_await data.lock()` suspends the coroutine if the lock is contended,
+ * instead of blocking the thread; the result is a `unique_guarded_data_lock`.
+ *
+ * `co_await data.lock(executor)` resumes the coroutine by invoking
+ * `executor(std::coroutine_handle<>)` if it was suspended, e.g. to schedule it
+ * on a thread pool; otherwise, it is resumed by the thread that unlocks. As
+ * with `async_mutex::lock_async()`, the executor must be `noexcept`.
+ */
+template <class T>
+class async_guarded_data {
+ public:
+  using mutex_type = async_mutex;
+
+  template <class U, class TExecutor>
+  class awaiter {
+   public:
+    template <class E>
+    awaiter(U* data, async_mutex& mutex, E&& executor)
+      : mData(data),
+        mInner(mutex, std::forward<E>(executor)) {}
+
+    [[nodiscard]]
+    bool await_ready() noexcept {
+      return mInner.await_ready();
+    }
+
+    bool await_suspend(const std::coroutine_handle<> handle) noexcept {
+      return mInner.await_suspend(handle);
+    }
+
+    [[nodiscard]]
+    unique_guarded_data_lock<U, async_mutex> await_resume() noexcept {
+      return {mInner.await_resume(), mData};
+    }
+
+   private:
+    U* mData;
+    async_mutex::awaiter<TExecutor> mInner;
+  };
+
+  template <class... Args>
+  explicit async_guarded_data(Args&&... args)
+    : mData {std::forward<Args>(args)...} {}
+
+  async_guarded_data(const async_guarded_data&) = delete;
+  async_guarded_data& operator=(const async_guarded_data&) = delete;
+
+  template <felly_detail::async_executor TExecutor
+              = felly_detail::async_inline_executor>
+  [[nodiscard]]
+  awaiter<T, std::decay_t<TExecutor>> lock(TExecutor&& executor = {}) {
+    return {&mData, mMutex, std::forward<TExecutor>(executor)};
+  }
+
+  template <felly_detail::async_executor TExecutor
+              = felly_detail::async_inline_executor>
+  [[nodiscard]]
+  awaiter<const T, std::decay_t<TExecutor>> lock(
+    TExecutor&& executor = {}) const {
+    return {&mData, mMutex, std::forward<TExecutor>(executor)};
+  }
+
+  /// Returns an empty lock if the mutex is already locked; never suspends
+  [[nodiscard]]
+  unique_guarded_data_lock<T, async_mutex> try_lock() noexcept {
+    std::unique_lock lock {mMutex, std::try_to_lock};
+    const auto owned = lock.owns_lock();
+    return {std::move(lock), owned ? &mData : nullptr};
+  }
+
+  [[nodiscard]]
+  unique_guarded_data_lock<const T, async_mutex> try_lock() const noexcept {
+    std::unique_lock lock {mMutex, std::try_to_lock};
+    const auto owned = lock.owns_lock();
+    return {std::move(lock), owned ? &mData : nullptr};
+  }
+
+ private:
+  mutable async_mutex mMutex;
+  T mData;
+};
+
+}// namespace felly::inline async_guarded_data_types
@@ -0,0 +1,447 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "hardware_interference_size.hpp"
+#include "scope_exit.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace felly::inline channel_types {
+
+enum class channel_mode {
+  // Single producer, single consumer
+  SPSC,
+  // Multiple producers, multiple consumers
+  MPMC,
+};
+
+}// namespace felly::inline channel_types
+
+namespace felly_detail {
+
+template <class T>
+concept channel_value = std::is_object_v<T> && !std::is_const_v<T>
+  && std::is_nothrow_move_constructible_v<T>
+  && std::is_nothrow_destructible_v<T>;
+
+template <class T>
+struct channel_slot {
+  alignas(T) std::byte mStorage[sizeof(T)];
+
+  T* get() noexcept {
+    return std::launder(reinterpret_cast<T*>(mStorage));
+  }
+};
+
+// Counts of threads that are blocked in `std::atomic::wait()`; these are on
+// their own cache line as they are read on every push and pop, but only
+// written to by threads that are about to block
+struct alignas(felly::hardware_destructive_interference_size)
+  channel_waiters {
+  std::atomic<std::uint32_t> mConsumers {0};
+  std::atomic<std::uint32_t> mProducers {0};
+
+  // Must be called after publishing a change to `value`
+  template <class T>
+  static void notify(
+    const std::atomic<std::uint32_t>& waiting,
+    std::atomic<T>& value) noexcept {
+    // Pairs with the `fetch_add()` in `wait()`: either we see the waiter, or
+    // the waiter sees our change
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) != 0) [[unlikely]] {
+      value.notify_all();
+    }
+  }
+
+  // Block until `value` is changed from `old`
+  template <class T>
+  static void wait(
+    std::atomic<std::uint32_t>& waiting,
+    const std::atomic<T>& value,
+    const T old) noexcept {
+    waiting.fetch_add(1, std::memory_order_seq_cst);
+    if (value.load(std::memory_order_seq_cst) == old) {
+      value.wait(old, std::memory_order_acquire);
+    }
+    waiting.fetch_sub(1, std::memory_order_relaxed);
+  }
+};
+
+/* A ring buffer with separate read and write indices.
+ *
+ * Each side caches the other side's index, so that it only needs to read
+ * the other side's cache line when the buffer appears to be full or empty.
+ */
+template <class T, std::size_t TCapacity>
+class channel_spsc_ring {
+ public:
+  channel_spsc_ring() = default;
+
+  ~channel_spsc_ring() {
+    const auto tail = mProducer.mTail.load(std::memory_order_relaxed);
+    for (auto i = mConsumer.mHead.load(std::memory_order_relaxed); i != tail;
+         ++i) {
+      std::destroy_at(mSlots[i % TCapacity].get());
+    }
+  }
+
+  // Moves from `value` on success
+  bool try_push(T& value) noexcept {
+    const auto tail = mProducer.mTail.load(std::memory_order_relaxed);
+    if (tail - mProducer.mCachedHead == TCapacity) {
+      mProducer.mCachedHead = mConsumer.mHead.load(std::memory_order_acquire);
+      if (tail - mProducer.mCachedHead == TCapacity) {
+        return false;
+      }
+    }
+    std::construct_at(mSlots[tail % TCapacity].get(), std::move(value));
+    mProducer.mTail.store(tail + 1, std::memory_order_release);
+    channel_waiters::notify(mWaiters.mConsumers, mProducer.mTail);
+    return true;
+  }
+
+  // Invokes `f(T&&)` for up to `max` values, publishing the new read index
+  // once
+  template <class F>
+  std::size_t try_pop_n(const std::size_t max, F&& f) {
+    const auto head = mConsumer.mHead.load(std::memory_order_relaxed);
+    if (head == mConsumer.mCachedTail) {
+      mConsumer.mCachedTail = mProducer.mTail.load(std::memory_order_acquire);
+    }
+    const auto count = std::min(max, mConsumer.mCachedTail - head);
+    if (count == 0) {
+      return 0;
+    }
+
+    std::size_t i = 0;
+    // Values are consumed even if `f` throws
+    const felly::scope_exit publish {[&] {
+      mConsumer.mHead.store(head + i, std::memory_order_release);
+      channel_waiters::notify(mWaiters.mProducers, mConsumer.mHead);
+    }};
+    while (i < count) {
+      const auto value = mSlots[(head + i) % TCapacity].get();
+      const felly::scope_exit destroy {[&] {
+        std::destroy_at(value);
+        ++i;
+      }};
+      std::invoke(f, std::move(*value));
+    }
+    return count;
+  }
+
+  void wait_until_not_full() noexcept {
+    while (true) {
+      const auto head = mConsumer.mHead.load(std::memory_order_acquire);
+      if (mProducer.mTail.load(std::memory_order_relaxed) - head != TCapacity) {
+        return;
+      }
+      channel_waiters::wait(mWaiters.mProducers, mConsumer.mHead, head);
+    }
+  }
+
+  void wait_until_not_empty() noexcept {
+    while (true) {
+      const auto tail = mProducer.mTail.load(std::memory_order_acquire);
+      if (mConsumer.mHead.load(std::memory_order_relaxed) != tail) {
+        return;
+      }
+      channel_waiters::wait(mWaiters.mConsumers, mProducer.mTail, tail);
+    }
+  }
+
+ private:
+  // Indices are not wrapped, so that full and empty can be distinguished
+  // without an extra slot
+  struct alignas(felly::hardware_destructive_interference_size) {
+    std::atomic<std::size_t> mHead {0};
+    std::size_t mCachedTail {0};
+  } mConsumer;
+
+  struct alignas(felly::hardware_destructive_interference_size) {
+    std::atomic<std::size_t> mTail {0};
+    std::size_t mCachedHead {0};
+  } mProducer;
+
+  channel_waiters mWaiters;
+
+  alignas(felly::hardware_destructive_interference_size)
+    std::array<channel_slot<T>, TCapacity> mSlots;
+};
+
+/* A bounded MPMC ring buffer, based on Dmitry Vyukov's design.
+ *
+ * Each slot has a sequence number, which indicates whether it is ready to be
+ * written or read for a given position; producers and consumers claim
+ * positions with a compare-exchange on the shared write or read index.
+ */
+template <class T, std::size_t TCapacity>
+class channel_mpmc_ring {
+ public:
+  channel_mpmc_ring() noexcept {
+    for (std::size_t i = 0; i < TCapacity; ++i) {
+      mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~channel_mpmc_ring() {
+    const auto tail = mTail.load(std::memory_order_relaxed);
+    for (auto i = mHead.load(std::memory_order_relaxed); i != tail; ++i) {
+      std::destroy_at(mSlots[i % TCapacity].get());
+    }
+  }
+
+  // Moves from `value` on success
+  bool try_push(T& value) noexcept {
+    auto pos = mTail.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = mSlots[pos % TCapacity];
+      const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+      if (diff < 0) {
+        // Not yet read in the previous pass
+        return false;
+      }
+      if (diff > 0) {
+        // Another producer claimed this position
+        pos = mTail.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (mTail.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed)) {
+        std::construct_at(slot.get(), std::move(value));
+        slot.mSequence.store(pos + 1, std::memory_order_release);
+        channel_waiters::notify(mWaiters.mConsumers, slot.mSequence);
+        return true;
+      }
+    }
+  }
+
+  template <class F>
+  std::size_t try_pop_n(const std::size_t max, F&& f) {
+    std::size_t count = 0;
+    while (count < max && try_pop(f)) {
+      ++count;
+    }
+    return count;
+  }
+
+  void wait_until_not_full() noexcept {
+    while (true) {
+      const auto pos = mTail.load(std::memory_order_relaxed);
+      auto& slot = mSlots[pos % TCapacity];
+      const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+      if (static_cast<std::ptrdiff_t>(sequence - pos) >= 0) {
+        return;
+      }
+      channel_waiters::wait(mWaiters.mProducers, slot.mSequence, sequence);
+    }
+  }
+
+  void wait_until_not_empty() noexcept {
+    while (true) {
+      const auto pos = mHead.load(std::memory_order_relaxed);
+      auto& slot = mSlots[pos % TCapacity];
+      const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+      if (static_cast<std::ptrdiff_t>(sequence - (pos + 1)) >= 0) {
+        return;
+      }
+      channel_waiters::wait(mWaiters.mConsumers, slot.mSequence, sequence);
+    }
+  }
+
+ private:
+  struct slot_type : channel_slot<T> {
+    std::atomic<std::size_t> mSequence;
+  };
+
+  alignas(felly::hardware_destructive_interference_size)
+    std::atomic<std::size_t> mHead {0};
+  alignas(felly::hardware_destructive_interference_size)
+    std::atomic<std::size_t> mTail {0};
+
+  channel_waiters mWaiters;
+
+  alignas(felly::hardware_destructive_interference_size)
+    std::array<slot_type, TCapacity> mSlots;
+
+  template <class F>
+  bool try_pop(F& f) {
+    auto pos = mHead.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = mSlots[pos % TCapacity];
+      const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+      if (diff < 0) {
+        // Not yet written
+        return false;
+      }
+      if (diff > 0) {
+        // Another consumer claimed this position
+        pos = mHead.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (mHead.compare_exchange_weak(
+            pos, pos + 1, std::memory_order_relaxed)) {
+        const auto value = slot.get();
+        // Values are consumed even if `f` throws
+        const felly::scope_exit release {[&] {
+          std::destroy_at(value);
+          slot.mSequence.store(pos + TCapacity, std::memory_order_release);
+          channel_waiters::notify(mWaiters.mProducers, slot.mSequence);
+        }};
+        std::invoke(f, std::move(*value));
+        return true;
+      }
+    }
+  }
+};
+
+}// namespace felly_detail
+
+namespace felly::inline channel_types {
+
+/** A bounded, lock-free queue for passing values between threads.
+ *
+ * This is an alternative to `guarded_data<std::deque<T>>`; storage for
+ * `TCapacity` values is inline, so there are no allocations after
+ * construction. The read and write indices are on separate cache lines.
+ *
+ * `channel_mode::SPSC` is only safe with at most one thread pushing and at
+ * most one thread popping at a time; `channel_mode::MPMC` has no such
+ * restriction.
+ *
+ * `push()` and `pop()` block while the channel is full or empty, using
+ * `std::atomic::wait()`; the `try_` variants never block. Values must be
+ * nothrow-move-constructible, but they do not need to be copyable.
+ */
+template <
+  felly_detail::channel_value T,
+  std::size_t TCapacity,
+  channel_mode TMode = channel_mode::MPMC>
+  requires(TCapacity > 0)
+class channel {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  static constexpr channel_mode mode = TMode;
+
+  channel() = default;
+  channel(const channel&) = delete;
+  channel& operator=(const channel&) = delete;
+
+  [[nodiscard]]
+  static constexpr size_type capacity() noexcept {
+    return TCapacity;
+  }
+
+  /// Returns false if the channel is full; `value` is only moved from if
+  /// this returns true
+  [[nodiscard]]
+  bool try_push(T&& value) noexcept {
+    return mRing.try_push(value);
+  }
+
+  [[nodiscard]]
+  bool try_push(const T& value)
+    requires std::copy_constructible<T>
+  {
+    T copy {value};
+    return mRing.try_push(copy);
+  }
+
+  /// Push a value, blocking while the channel is full
+  void push(T&& value) noexcept {
+    while (!mRing.try_push(value)) {
+      mRing.wait_until_not_full();
+    }
+  }
+
+  void push(const T& value)
+    requires std::copy_constructible<T>
+  {
+    push(T {value});
+  }
+
+  /// Construct a value, then push it
+  template <class... Args>
+    requires std::constructible_from<T, Args&&...>
+  void emplace(Args&&... args) {
+    push(T(std::forward<Args>(args)...));
+  }
+
+  /// Returns `std::nullopt` if the channel is empty
+  [[nodiscard]]
+  std::optional<T> try_pop() noexcept {
+    std::optional<T> ret;
+    mRing.try_pop_n(1, [&ret](T&& value) noexcept {
+      ret.emplace(std::move(value));
+    });
+    return ret;
+  }
+
+  /// Pop a value, blocking while the channel is empty
+  [[nodiscard]]
+  T pop() noexcept {
+    while (true) {
+      if (auto ret = try_pop()) {
+        return std::move(*ret);
+      }
+      mRing.wait_until_not_empty();
+    }
+  }
+
+  /** Move up to `max` values to `out`, without blocking.
+   *
+   * Returns the number of values moved; for `channel_mode::SPSC`, the read
+   * index is only updated once. If writing to `out` throws, that value is
+   * lost.
+   */
+  template <std::output_iterator<T&&> TOut>
+  size_type try_pop_n(TOut out, const size_type max) {
+    return mRing.try_pop_n(max, [&out](T&& value) {
+      *out = std::move(value);
+      ++out;
+    });
+  }
+
+  /// Like `try_pop_n()`, but blocks until at least one value is available
+  template <std::output_iterator<T&&> TOut>
+  size_type pop_n(TOut out, const size_type max) {
+    if (max == 0) {
+      return 0;
+    }
+    while (true) {
+      if (const auto count = try_pop_n(out, max)) {
+        return count;
+      }
+      mRing.wait_until_not_empty();
+    }
+  }
+
+ private:
+  std::conditional_t<
+    TMode == channel_mode::SPSC,
+    felly_detail::channel_spsc_ring<T, TCapacity>,
+    felly_detail::channel_mpmc_ring<T, TCapacity>>
+    mRing;
+};
+
+template <class T, std::size_t TCapacity>
+using spsc_channel = channel<T, TCapacity, channel_mode::SPSC>;
+
+}// namespace felly::inline channel_types
@@ -0,0 +1,20 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+// For error paths, e.g. functions that throw exceptions; this keeps them out
+// of the callers' code, improving instruction cache usage and inlining
+// decisions on the hot path.
+#if __has_cpp_attribute(gnu::cold)
+#define FELLY_COLD [[gnu::cold]]
+#else
+#define FELLY_COLD
+#endif
+
+#if __has_cpp_attribute(msvc::noinline)
+#define FELLY_NOINLINE [[msvc::noinline]]
+#elif __has_cpp_attribute(gnu::noinline)
+#define FELLY_NOINLINE [[gnu::noinline]]
+#else
+#define FELLY_NOINLINE
+#endif
@@ -0,0 +1,78 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "cold.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <exception>
+#include <utility>
+
+// What felly does when a precondition or conversion check fails:
+// - `FELLY_ERROR_POLICY_THROW`: throw an exception; the default if exceptions
+//   are enabled
+// - `FELLY_ERROR_POLICY_TERMINATE`: call `FELLY_ERROR_HANDLER` with the
+//   exception's message; the default if exceptions are disabled
+// - `FELLY_ERROR_POLICY_UNCHECKED`: skip the check, but `assert()` it
+//
+// The policy must be the same in every translation unit that includes felly.
+#define FELLY_ERROR_POLICY_THROW 1
+#define FELLY_ERROR_POLICY_TERMINATE 2
+#define FELLY_ERROR_POLICY_UNCHECKED 3
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define FELLY_HAS_EXCEPTIONS 1
+#else
+#define FELLY_HAS_EXCEPTIONS 0
+#endif
+
+#ifndef FELLY_ERROR_POLICY
+#if FELLY_HAS_EXCEPTIONS
+#define FELLY_ERROR_POLICY FELLY_ERROR_POLICY_THROW
+#else
+#define FELLY_ERROR_POLICY FELLY_ERROR_POLICY_TERMINATE
+#endif
+#endif
+
+#if FELLY_ERROR_POLICY == FELLY_ERROR_POLICY_THROW && !FELLY_HAS_EXCEPTIONS
+#error "FELLY_ERROR_POLICY_THROW requires exceptions"
+#endif
+
+// Must name a `[[noreturn]] void(const char* message) noexcept` function
+#ifndef FELLY_ERROR_HANDLER
+#define FELLY_ERROR_HANDLER ::felly_detail::default_error_handler
+#endif
+
+// `if (FELLY_CHECK_FAILED(condition)) [[unlikely]] { raise_error<E>(...); }`
+//
+// With `FELLY_ERROR_POLICY_UNCHECKED`, the condition is only evaluated by
+// `assert()`.
+#if FELLY_ERROR_POLICY == FELLY_ERROR_POLICY_UNCHECKED
+#define FELLY_CHECK_FAILED(...) (assert(__VA_ARGS__), false)
+#else
+#define FELLY_CHECK_FAILED(...) (!(__VA_ARGS__))
+#endif
+
+namespace felly_detail {
+
+[[noreturn]] FELLY_COLD inline void default_error_handler(
+  const char* const message) noexcept {
+  std::fprintf(stderr, "felly: %s\n", message);
+  std::terminate();
+}
+
+/// Throws an `E`, or passes its message to `FELLY_ERROR_HANDLER`
+template <class E, class... Args>
+[[noreturn]] FELLY_COLD FELLY_NOINLINE void raise_error(Args&&... args) {
+#if FELLY_ERROR_POLICY == FELLY_ERROR_POLICY_THROW
+  throw E(std::forward<Args>(args)...);
+#else
+  const E error(std::forward<Args>(args)...);
+  FELLY_ERROR_HANDLER(error.what());
+  // In case the handler returns
+  std::terminate();
+#endif
+}
+
+}// namespace felly_detail
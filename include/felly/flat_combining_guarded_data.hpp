@@ -0,0 +1,217 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "adaptive_mutex.hpp"
+#include "error_policy.hpp"
+#include "hardware_interference_size.hpp"
+#include "scope_exit.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace felly_detail {
+
+template <class T>
+struct flat_combining_request {
+  using run_type = void (*)(flat_combining_request*, T&) noexcept;
+
+  explicit flat_combining_request(const run_type run) noexcept : mRun(run) {}
+
+  run_type mRun;
+  std::atomic<bool> mDone {false};
+  std::exception_ptr mException;
+};
+
+template <class T, class F>
+struct flat_combining_request_for : flat_combining_request<T> {
+  using result_type = std::invoke_result_t<F&, T&>;
+  struct empty {};
+
+  explicit flat_combining_request_for(F& f) noexcept
+    : flat_combining_request<T> {&run}, mF(f) {}
+
+  F& mF;
+  std::conditional_t<
+    std::is_void_v<result_type>,
+    empty,
+    std::optional<result_type>>
+    mResult;
+
+  static void run(flat_combining_request<T>* base, T& data) noexcept {
+    auto& self = *static_cast<flat_combining_request_for*>(base);
+#if FELLY_HAS_EXCEPTIONS
+    try {
+      self.invoke(data);
+    } catch (...) {
+      self.mException = std::current_exception();
+    }
+#else
+    self.invoke(data);
+#endif
+    // The requesting thread may destroy this as soon as it is marked done
+    self.mDone.store(true, std::memory_order_release);
+  }
+
+  void invoke(T& data) {
+    if constexpr (std::is_void_v<result_type>) {
+      std::invoke(mF, data);
+    } else {
+      mResult.emplace(std::invoke(mF, data));
+    }
+  }
+
+  result_type take() {
+#if FELLY_HAS_EXCEPTIONS
+    if (this->mException) {
+      std::rethrow_exception(this->mException);
+    }
+#endif
+    if constexpr (!std::is_void_v<result_type>) {
+      return std::move(*mResult);
+    }
+  }
+};
+
+// A small per-thread number, used to spread threads over slots
+inline std::size_t flat_combining_thread_hint() noexcept {
+  static std::atomic<std::size_t> next {0};
+  thread_local const auto hint = next.fetch_add(1, std::memory_order_relaxed);
+  return hint;
+}
+
+}// namespace felly_detail
+
+namespace felly::inline flat_combining_guarded_data_types {
+
+/** Data that is accessed by invoking functions while holding its lock.
+ *
+ * Under contention, waiting threads publish their function to one of `Slots`
+ * slots instead of competing for the lock; whichever thread holds the lock
+ * invokes the published functions in a batch, while the data is in its cache,
+ * and hands the results back.
+ *
+ * When uncontended, `with_lock()` is a `try_lock()`, the function call, a load
+ * of the pending request count, and an `unlock()`.
+ *
+ * Functions may be invoked on another thread, so they should not depend on
+ * thread-local state; exceptions are rethrown on the calling thread.
+ */
+template <class T, class TMutex = std::mutex, std::size_t Slots = 16>
+  requires(Slots > 0)
+class flat_combining_guarded_data {
+ public:
+  using mutex_type = TMutex;
+
+  template <class... Args>
+  explicit flat_combining_guarded_data(Args&&... args)
+    : mData {std::forward<Args>(args)...} {}
+
+  flat_combining_guarded_data(const flat_combining_guarded_data&) = delete;
+  flat_combining_guarded_data& operator=(const flat_combining_guarded_data&)
+    = delete;
+
+  /** Invoke `f(T&)` while holding the lock, possibly on another thread.
+   *
+   * Returns the result of `f()`; references are not supported, as they would
+   * escape the lock.
+   */
+  template <std::invocable<T&> F>
+  std::invoke_result_t<F&, T&> with_lock(F&& f) {
+    using request_for = felly_detail::flat_combining_request_for<T, F>;
+    static_assert(
+      !std::is_reference_v<typename request_for::result_type>,
+      "with_lock() callbacks must return by value");
+
+    if (mMutex.try_lock()) [[likely]] {
+      const scope_exit unlock {[this] { combine_and_unlock(); }};
+      return std::invoke(f, mData);
+    }
+
+    request_for request {f};
+    if (!publish(&request)) {
+      // All slots are in use; wait for the lock as usual
+      mMutex.lock();
+      const scope_exit unlock {[this] { combine_and_unlock(); }};
+      return std::invoke(f, mData);
+    }
+
+    for (std::uint32_t i = 0; i < MaxSpins; ++i) {
+      if (request.mDone.load(std::memory_order_acquire)) {
+        return request.take();
+      }
+      if (mMutex.try_lock()) {
+        // Our request is either already done, or in a slot; either way, it
+        // will be done after combining
+        combine_and_unlock();
+        return request.take();
+      }
+      felly_detail::cpu_relax();
+    }
+
+    mMutex.lock();
+    combine_and_unlock();
+    return request.take();
+  }
+
+ private:
+  using request_type = felly_detail::flat_combining_request<T>;
+
+  static constexpr std::uint32_t MaxSpins = 128;
+
+  struct alignas(hardware_destructive_interference_size) slot {
+    std::atomic<request_type*> mRequest {nullptr};
+  };
+
+  TMutex mMutex;
+  T mData;
+
+  // Never less than the number of requests in slots
+  alignas(hardware_destructive_interference_size)
+    std::atomic<std::size_t> mPending {0};
+  std::array<slot, Slots> mSlots {};
+
+  bool publish(request_type* request) noexcept {
+    mPending.fetch_add(1, std::memory_order_relaxed);
+    const auto hint = felly_detail::flat_combining_thread_hint();
+    for (std::size_t i = 0; i < Slots; ++i) {
+      auto& slot = mSlots[(hint + i) % Slots];
+      request_type* expected = nullptr;
+      if (slot.mRequest.compare_exchange_strong(
+            expected,
+            request,
+            std::memory_order_release,
+            std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    mPending.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Must be called while holding the lock; each slot is visited once, so a
+  // steady stream of requests can't keep the combiner here indefinitely
+  void combine_and_unlock() noexcept {
+    if (mPending.load(std::memory_order_acquire) != 0) {
+      for (auto&& slot: mSlots) {
+        const auto request
+          = slot.mRequest.exchange(nullptr, std::memory_order_acquire);
+        if (request) {
+          mPending.fetch_sub(1, std::memory_order_relaxed);
+          request->mRun(request, mData);
+        }
+      }
+    }
+    mMutex.unlock();
+  }
+};
+
+}// namespace felly::inline flat_combining_guarded_data_types
@@ -2,16 +2,70 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "error_policy.hpp"
+#include "hardware_interference_size.hpp"
+
+#include <chrono>
+#include <concepts>
+#include <functional>
 #include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
-namespace felly::inline guarded_data_types {
+namespace felly_detail {
+
+template <class T>
+concept shared_lockable = requires(T& m) {
+  m.lock_shared();
+  { m.try_lock_shared() } -> std::convertible_to<bool>;
+  m.unlock_shared();
+};
+
+template <class T>
+concept timed_lockable = requires(
+  T& m,
+  const std::chrono::steady_clock::duration& timeout,
+  const std::chrono::steady_clock::time_point& deadline) {
+  { m.try_lock_for(timeout) } -> std::convertible_to<bool>;
+  { m.try_lock_until(deadline) } -> std::convertible_to<bool>;
+};
+
+// A mutex that can be waited on while locked, e.g. `felly::waitable_mutex`
+template <class T>
+concept waitable_lockable = requires(
+  T& m,
+  std::unique_lock<T>& lock,
+  bool (*pred)(),
+  const std::chrono::steady_clock::duration& timeout,
+  const std::chrono::steady_clock::time_point& deadline) {
+  m.wait(lock, pred);
+  { m.wait_for(lock, timeout, pred) } -> std::convertible_to<bool>;
+  { m.wait_until(lock, deadline, pred) } -> std::convertible_to<bool>;
+  m.notify_one();
+  m.notify_all();
+};
 
+// A mutex that records statistics, e.g. `felly::instrumented_mutex`
 template <class T>
+concept instrumented_lockable = requires(const T& m) { m.stats(); };
+
+struct guarded_data_access;
+
+}// namespace felly_detail
+
+namespace felly::inline guarded_data_types {
+
+template <class T, class TMutex>
+struct shared_guarded_data_lock;
+
+template <class T, class TMutex = std::mutex>
 struct unique_guarded_data_lock {
   unique_guarded_data_lock() = delete;
 
-  unique_guarded_data_lock(std::unique_lock<std::mutex> lock, T* data)
+  unique_guarded_data_lock(std::unique_lock<TMutex> lock, T* data)
     : mLock(std::move(lock)),
       mData(data) {}
   unique_guarded_data_lock(const unique_guarded_data_lock&) = delete;
@@ -60,40 +114,412 @@ struct unique_guarded_data_lock {
   }
 
   void unlock() {
-    if (!(mData && mLock.owns_lock())) {
-      throw std::logic_error("Unlocking a lock that isn't locked");
+    if (FELLY_CHECK_FAILED(mData && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Unlocking a lock that isn't locked");
     }
     mData = nullptr;
     mLock.unlock();
   }
 
+  /** Exchange exclusive ownership for shared ownership.
+   *
+   * This is not atomic: the exclusive lock is released before the shared lock
+   * is acquired, so another writer may modify the data in between.
+   */
+  [[nodiscard]]
+  shared_guarded_data_lock<T, TMutex> downgrade() &&
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    if (FELLY_CHECK_FAILED(mData && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Downgrading a lock that isn't locked");
+    }
+    auto& mutex = *mLock.mutex();
+    mLock.unlock();
+    return {std::shared_lock {mutex}, std::exchange(mData, nullptr)};
+  }
+
+  /** Unlock until notified and `pred(data)` is true.
+   *
+   * The predicate is only invoked while the lock is held.
+   */
+  template <std::predicate<T&> TPredicate>
+  void wait(TPredicate&& pred)
+    requires felly_detail::waitable_lockable<TMutex>
+  {
+    if (FELLY_CHECK_FAILED(mData && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Waiting on a lock that isn't locked");
+    }
+    mLock.mutex()->wait(mLock, [&] { return std::invoke(pred, *mData); });
+  }
+
+  /// Returns the final result of `pred(data)`
+  template <class Rep, class Period, std::predicate<T&> TPredicate>
+  bool wait_for(
+    const std::chrono::duration<Rep, Period>& timeout,
+    TPredicate&& pred)
+    requires felly_detail::waitable_lockable<TMutex>
+  {
+    if (FELLY_CHECK_FAILED(mData && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Waiting on a lock that isn't locked");
+    }
+    return mLock.mutex()->wait_for(
+      mLock, timeout, [&] { return std::invoke(pred, *mData); });
+  }
+
+  /// Returns the final result of `pred(data)`
+  template <class Clock, class Duration, std::predicate<T&> TPredicate>
+  bool wait_until(
+    const std::chrono::time_point<Clock, Duration>& deadline,
+    TPredicate&& pred)
+    requires felly_detail::waitable_lockable<TMutex>
+  {
+    if (FELLY_CHECK_FAILED(mData && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Waiting on a lock that isn't locked");
+    }
+    return mLock.mutex()->wait_until(
+      mLock, deadline, [&] { return std::invoke(pred, *mData); });
+  }
+
+ private:
+  std::unique_lock<TMutex> mLock;
+  T* mData;
+};
+
+/** A read-only lock, for use with a shared mutex.
+ *
+ * `T` may be mutable - in that case, `upgrade()` gives mutable access - but
+ * this lock only ever exposes `const T`.
+ */
+template <class T, class TMutex = std::shared_mutex>
+struct shared_guarded_data_lock {
+  shared_guarded_data_lock() = delete;
+
+  shared_guarded_data_lock(std::shared_lock<TMutex> lock, T* data)
+    : mLock(std::move(lock)),
+      mData(data) {}
+  shared_guarded_data_lock(const shared_guarded_data_lock&) = delete;
+  shared_guarded_data_lock& operator=(const shared_guarded_data_lock&) = delete;
+
+  shared_guarded_data_lock& operator=(
+    shared_guarded_data_lock&& other) noexcept {
+    if (std::addressof(other) == this) {
+      return *this;
+    }
+    mLock = std::move(other.mLock);
+    mData = std::exchange(other.mData, nullptr);
+    return *this;
+  }
+
+  shared_guarded_data_lock(shared_guarded_data_lock&& other) noexcept {
+    *this = std::move(other);
+  }
+
+  operator bool() const noexcept { return mData != nullptr; }
+
+  T const* operator->() const noexcept { return mData; }
+
+  [[nodiscard]]
+  const T& get() const noexcept {
+    return *mData;
+  }
+
+  [[nodiscard]]
+  const T& operator*() const noexcept {
+    return *mData;
+  }
+
+  void unlock() {
+    if (FELLY_CHECK_FAILED(mData && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Unlocking a lock that isn't locked");
+    }
+    mData = nullptr;
+    mLock.unlock();
+  }
+
+  /** Exchange shared ownership for exclusive ownership.
+   *
+   * This is not atomic: the shared lock is released before the exclusive lock
+   * is acquired, so any conditions checked under the shared lock must be
+   * checked again.
+   */
+  [[nodiscard]]
+  unique_guarded_data_lock<T, TMutex> upgrade() && {
+    if (FELLY_CHECK_FAILED(mData && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Upgrading a lock that isn't locked");
+    }
+    auto& mutex = *mLock.mutex();
+    mLock.unlock();
+    return {std::unique_lock {mutex}, std::exchange(mData, nullptr)};
+  }
+
  private:
-  std::unique_lock<std::mutex> mLock;
+  std::shared_lock<TMutex> mLock;
   T* mData;
 };
 
 /* Totally not a Rust mutex.
  *
  * Hides the data so it can only be accessed via a lock guard.
+ *
+ * `TMutex` can be any Lockable type; if it is also SharedLockable (e.g.
+ * `std::shared_mutex`), `lock_shared()` is available for concurrent readers.
  */
-template <class T>
+template <class T, class TMutex = std::mutex>
 struct guarded_data {
+  using mutex_type = TMutex;
+
   template <class... Args>
   explicit guarded_data(Args&&... args) : mData {std::forward<Args>(args)...} {}
 
+  /** Construct both the mutex and the data from tuples of arguments, e.g.
+   *
+   *  felly::instrumented_guarded_data<int> counter {
+   *    std::piecewise_construct,
+   *    std::forward_as_tuple("counter"),
+   *    std::forward_as_tuple(0)};
+   */
+  template <class... MutexArgs, class... DataArgs>
+  guarded_data(
+    std::piecewise_construct_t,
+    std::tuple<MutexArgs...> mutexArgs,
+    std::tuple<DataArgs...> dataArgs)
+    : mMutex(std::make_from_tuple<TMutex>(std::move(mutexArgs))),
+      mData(std::make_from_tuple<T>(std::move(dataArgs))) {}
+
   [[nodiscard]]
   auto lock() {
-    return unique_guarded_data_lock<T>(std::unique_lock {mMutex}, &mData);
+    return unique_guarded_data_lock<T, TMutex>(
+      std::unique_lock {mMutex}, &mData);
   }
 
   [[nodiscard]]
   auto lock() const {
-    return unique_guarded_data_lock<const T>(std::unique_lock {mMutex}, &mData);
+    return unique_guarded_data_lock<const T, TMutex>(
+      std::unique_lock {mMutex}, &mData);
+  }
+
+  /** Invoke `f(T&)` while holding the lock.
+   *
+   * Returns a copy of the result of `f()`, so that references to the data can't
+   * escape the lock.
+   *
+   * Unconstrained so that generic lambdas don't need to be valid for both
+   * `T&` and `const T&`.
+   */
+  template <class F>
+  auto with_lock(F&& f) {
+    const std::unique_lock lock {mMutex};
+    return std::invoke(std::forward<F>(f), mData);
+  }
+
+  template <class F>
+  auto with_lock(F&& f) const {
+    const std::unique_lock lock {mMutex};
+    return std::invoke(std::forward<F>(f), std::as_const(mData));
+  }
+
+  /// Returns an empty lock if the mutex is already locked
+  [[nodiscard]]
+  auto try_lock() {
+    return make_lock<T>(std::unique_lock {mMutex, std::try_to_lock}, &mData);
+  }
+
+  [[nodiscard]]
+  auto try_lock() const {
+    return make_lock<const T>(
+      std::unique_lock {mMutex, std::try_to_lock}, &mData);
+  }
+
+  /// Returns an empty lock if the mutex can't be locked within the timeout
+  template <class Rep, class Period>
+  [[nodiscard]]
+  auto try_lock_for(const std::chrono::duration<Rep, Period>& timeout)
+    requires felly_detail::timed_lockable<TMutex>
+  {
+    return make_lock<T>(std::unique_lock {mMutex, timeout}, &mData);
+  }
+
+  template <class Rep, class Period>
+  [[nodiscard]]
+  auto try_lock_for(const std::chrono::duration<Rep, Period>& timeout) const
+    requires felly_detail::timed_lockable<TMutex>
+  {
+    return make_lock<const T>(std::unique_lock {mMutex, timeout}, &mData);
+  }
+
+  /// Returns an empty lock if the mutex can't be locked before the deadline
+  template <class Clock, class Duration>
+  [[nodiscard]]
+  auto try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline)
+    requires felly_detail::timed_lockable<TMutex>
+  {
+    return make_lock<T>(std::unique_lock {mMutex, deadline}, &mData);
+  }
+
+  template <class Clock, class Duration>
+  [[nodiscard]]
+  auto try_lock_until(
+    const std::chrono::time_point<Clock, Duration>& deadline) const
+    requires felly_detail::timed_lockable<TMutex>
+  {
+    return make_lock<const T>(std::unique_lock {mMutex, deadline}, &mData);
+  }
+
+  [[nodiscard]]
+  auto lock_shared()
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    return shared_guarded_data_lock<T, TMutex>(
+      std::shared_lock {mMutex}, &mData);
+  }
+
+  [[nodiscard]]
+  auto lock_shared() const
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    return shared_guarded_data_lock<const T, TMutex>(
+      std::shared_lock {mMutex}, &mData);
+  }
+
+  /// Returns an empty lock if the mutex is exclusively locked
+  [[nodiscard]]
+  auto try_lock_shared()
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    return make_lock<T>(std::shared_lock {mMutex, std::try_to_lock}, &mData);
+  }
+
+  [[nodiscard]]
+  auto try_lock_shared() const
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    return make_lock<const T>(
+      std::shared_lock {mMutex, std::try_to_lock}, &mData);
+  }
+
+  /// Wake a thread that is in `unique_guarded_data_lock::wait()`
+  void notify_one() const noexcept
+    requires felly_detail::waitable_lockable<TMutex>
+  {
+    mMutex.notify_one();
+  }
+
+  /// Wake all threads that are in `unique_guarded_data_lock::wait()`
+  void notify_all() const noexcept
+    requires felly_detail::waitable_lockable<TMutex>
+  {
+    mMutex.notify_all();
+  }
+
+  /// Contention and hold-time statistics, e.g. from `instrumented_mutex`
+  [[nodiscard]]
+  auto stats() const noexcept
+    requires felly_detail::instrumented_lockable<TMutex>
+  {
+    return mMutex.stats();
   }
 
  private:
-  mutable std::mutex mMutex {};
+  friend struct felly_detail::guarded_data_access;
+
+  mutable TMutex mMutex {};
   T mData;
+
+  template <class U>
+  static auto make_lock(std::unique_lock<TMutex> lock, U* data) {
+    const auto owned = lock.owns_lock();
+    return unique_guarded_data_lock<U, TMutex>(
+      std::move(lock), owned ? data : nullptr);
+  }
+
+  template <class U>
+  static auto make_lock(std::shared_lock<TMutex> lock, U* data) {
+    const auto owned = lock.owns_lock();
+    return shared_guarded_data_lock<U, TMutex>(
+      std::move(lock), owned ? data : nullptr);
+  }
+};
+
+template <class T>
+using shared_guarded_data = guarded_data<T, std::shared_mutex>;
+
+/** A `guarded_data` that is aligned to avoid false sharing.
+ *
+ * The mutex and data share a cache line (if they fit), but no other object
+ * does; this is useful for arrays of `guarded_data`, e.g. one per worker.
+ */
+template <class T, class TMutex = std::mutex>
+struct alignas(hardware_destructive_interference_size) aligned_guarded_data
+  : guarded_data<T, TMutex> {
+  using guarded_data<T, TMutex>::guarded_data;
+};
+
+}// namespace felly::inline guarded_data_types
+
+namespace felly_detail {
+
+// Used by free functions that need to lock several `guarded_data` at once
+struct guarded_data_access {
+  template <class T, class TMutex>
+  static TMutex& mutex(const felly::guarded_data<T, TMutex>& guarded) noexcept {
+    return guarded.mMutex;
+  }
+
+  template <class T, class TMutex>
+  static T* data(felly::guarded_data<T, TMutex>& guarded) noexcept {
+    return std::addressof(guarded.mData);
+  }
+
+  template <class T, class TMutex>
+  static const T* data(const felly::guarded_data<T, TMutex>& guarded) noexcept {
+    return std::addressof(guarded.mData);
+  }
 };
 
+template <class T, class TMutex>
+void guarded_data_base_test(const felly::guarded_data<T, TMutex>&);
+
+// `guarded_data`, or a subclass such as `aligned_guarded_data`
+template <class T>
+concept guarded_data_instance
+  = requires(T& v) { felly_detail::guarded_data_base_test(v); };
+
+}// namespace felly_detail
+
+namespace felly::inline guarded_data_types {
+
+/** Lock several `guarded_data`s at once, without deadlock.
+ *
+ * This uses `std::lock()`'s deadlock-avoidance algorithm, so the order of the
+ * parameters does not matter. The result is a tuple of
+ * `unique_guarded_data_lock`s, in the same order as the parameters, e.g.
+ *
+ *  auto [from, to] = felly::lock_all(queue_a, queue_b);
+ *
+ * As with `std::lock()`, passing the same `guarded_data` twice is undefined
+ * behavior.
+ */
+template <felly_detail::guarded_data_instance... Ts>
+  requires(sizeof...(Ts) >= 2)
+[[nodiscard]]
+auto lock_all(Ts&... guarded) {
+  using access = felly_detail::guarded_data_access;
+  std::tuple locks {
+    std::unique_lock {access::mutex(guarded), std::defer_lock}...};
+  std::apply([](auto&... unlocked) { std::lock(unlocked...); }, locks);
+  return std::apply(
+    [&](auto&... locked) {
+      return std::tuple {unique_guarded_data_lock(
+        std::move(locked), access::data(guarded))...};
+    },
+    locks);
+}
+
 }// namespace felly::inline guarded_data_types
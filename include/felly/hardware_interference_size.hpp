@@ -0,0 +1,32 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace felly::inline hardware_interference_size_types {
+
+#ifdef __cpp_lib_hardware_interference_size
+// GCC warns that these values may differ between `-mtune` settings, which is
+// an ABI problem if they're used in a header; we accept that, as ABI
+// compatibility is not a goal of this library, and it's what the standard
+// constants are for.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t hardware_destructive_interference_size
+  = std::hardware_destructive_interference_size;
+inline constexpr std::size_t hardware_constructive_interference_size
+  = std::hardware_constructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+// Not provided by older versions of libc++, including some Apple Clang versions
+inline constexpr std::size_t hardware_destructive_interference_size = 64;
+inline constexpr std::size_t hardware_constructive_interference_size = 64;
+#endif
+
+}// namespace felly::inline hardware_interference_size_types
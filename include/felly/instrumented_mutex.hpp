@@ -0,0 +1,207 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "guarded_data.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+
+namespace felly::inline instrumented_mutex_types {
+
+struct lock_stats {
+  std::string_view name;
+
+  std::uint64_t acquisitions {};
+  // Acquisitions where the lock was not immediately available
+  std::uint64_t contended_acquisitions {};
+
+  std::chrono::nanoseconds total_wait {};
+  std::chrono::nanoseconds max_wait {};
+
+  // Exclusive locks only
+  std::chrono::nanoseconds total_hold {};
+  std::chrono::nanoseconds max_hold {};
+};
+
+/** A mutex wrapper that records contention and hold times.
+ *
+ * This is intended for use as the mutex type for `guarded_data`, which then
+ * provides a `stats()` method. Other mutex types are unaffected.
+ *
+ * Statistics are relaxed atomics; as each statistic is updated separately, a
+ * `stats()` call that is concurrent with a lock or unlock may see some
+ * counters updated but not others.
+ *
+ * Shared locks are counted as acquisitions, but their hold times are not
+ * recorded, as there can be several concurrent holders.
+ */
+template <class TMutex = std::mutex, class TClock = std::chrono::steady_clock>
+class instrumented_mutex {
+ public:
+  instrumented_mutex() = default;
+
+  /// `name` must outlive the mutex; a string literal is usually best
+  explicit instrumented_mutex(const std::string_view name) noexcept
+    : mName(name) {}
+
+  instrumented_mutex(const instrumented_mutex&) = delete;
+  instrumented_mutex& operator=(const instrumented_mutex&) = delete;
+
+  void lock() {
+    if (mMutex.try_lock()) [[likely]] {
+      acquired_exclusive();
+      return;
+    }
+    const auto start = TClock::now();
+    mMutex.lock();
+    acquired_exclusive_after_wait(start);
+  }
+
+  [[nodiscard]]
+  bool try_lock() {
+    if (!mMutex.try_lock()) {
+      return false;
+    }
+    acquired_exclusive();
+    return true;
+  }
+
+  template <class Rep, class Period>
+  [[nodiscard]]
+  bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout)
+    requires felly_detail::timed_lockable<TMutex>
+  {
+    if (mMutex.try_lock()) {
+      acquired_exclusive();
+      return true;
+    }
+    const auto start = TClock::now();
+    if (!mMutex.try_lock_for(timeout)) {
+      return false;
+    }
+    acquired_exclusive_after_wait(start);
+    return true;
+  }
+
+  template <class Clock, class Duration>
+  [[nodiscard]]
+  bool try_lock_until(const std::chrono::time_point<Clock, Duration>& deadline)
+    requires felly_detail::timed_lockable<TMutex>
+  {
+    if (mMutex.try_lock()) {
+      acquired_exclusive();
+      return true;
+    }
+    const auto start = TClock::now();
+    if (!mMutex.try_lock_until(deadline)) {
+      return false;
+    }
+    acquired_exclusive_after_wait(start);
+    return true;
+  }
+
+  void unlock() {
+    const auto held = TClock::now() - mHoldStart;
+    mMutex.unlock();
+    record(held, mTotalHold, mMaxHold);
+  }
+
+  void lock_shared()
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    if (mMutex.try_lock_shared()) [[likely]] {
+      mAcquisitions.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    const auto start = TClock::now();
+    mMutex.lock_shared();
+    acquired_after_wait(TClock::now() - start);
+  }
+
+  [[nodiscard]]
+  bool try_lock_shared()
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    if (!mMutex.try_lock_shared()) {
+      return false;
+    }
+    mAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void unlock_shared()
+    requires felly_detail::shared_lockable<TMutex>
+  {
+    mMutex.unlock_shared();
+  }
+
+  [[nodiscard]]
+  lock_stats stats() const noexcept {
+    using std::chrono::nanoseconds;
+    constexpr auto relaxed = std::memory_order_relaxed;
+    return {
+      .name = mName,
+      .acquisitions = mAcquisitions.load(relaxed),
+      .contended_acquisitions = mContendedAcquisitions.load(relaxed),
+      .total_wait = nanoseconds {mTotalWait.load(relaxed)},
+      .max_wait = nanoseconds {mMaxWait.load(relaxed)},
+      .total_hold = nanoseconds {mTotalHold.load(relaxed)},
+      .max_hold = nanoseconds {mMaxHold.load(relaxed)},
+    };
+  }
+
+ private:
+  using counter_type = std::atomic<std::uint64_t>;
+  using duration_type = std::atomic<std::chrono::nanoseconds::rep>;
+
+  TMutex mMutex;
+  std::string_view mName;
+
+  counter_type mAcquisitions {};
+  counter_type mContendedAcquisitions {};
+  duration_type mTotalWait {};
+  duration_type mMaxWait {};
+  duration_type mTotalHold {};
+  duration_type mMaxHold {};
+
+  // Only accessed while exclusively locked
+  typename TClock::time_point mHoldStart {};
+
+  void acquired_exclusive() {
+    mHoldStart = TClock::now();
+    mAcquisitions.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void acquired_exclusive_after_wait(const typename TClock::time_point start) {
+    mHoldStart = TClock::now();
+    acquired_after_wait(mHoldStart - start);
+  }
+
+  void acquired_after_wait(const typename TClock::duration waited) {
+    mAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    mContendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    record(waited, mTotalWait, mMaxWait);
+  }
+
+  static void record(
+    const typename TClock::duration duration,
+    duration_type& total,
+    duration_type& max) {
+    const auto ns
+      = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    total.fetch_add(ns, std::memory_order_relaxed);
+    auto previous = max.load(std::memory_order_relaxed);
+    while (previous < ns
+           && !max.compare_exchange_weak(
+             previous, ns, std::memory_order_relaxed)) {}
+  }
+};
+
+template <class T, class TMutex = std::mutex>
+using instrumented_guarded_data = guarded_data<T, instrumented_mutex<TMutex>>;
+
+}// namespace felly::inline instrumented_mutex_types
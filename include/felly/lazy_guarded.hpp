@@ -0,0 +1,115 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "cold.hpp"
+#include "guarded_data.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace felly_detail {
+
+// Converts to the result of `f()`, so that the value is constructed in place
+// by `std::optional::emplace()`, even if it is not movable.
+//
+// Only used if needed: types with a converting constructor, such as
+// `std::any`, would otherwise be constructed from this helper instead
+template <class F>
+struct lazy_guarded_result {
+  F& mFunction;
+
+  operator std::invoke_result_t<F&>() const {
+    return std::invoke(mFunction);
+  }
+};
+
+template <class F, class T>
+concept lazy_guarded_initializer = std::invocable<F&>
+  && (std::same_as<std::remove_cv_t<std::invoke_result_t<F&>>, T>
+      || std::constructible_from<T, std::invoke_result_t<F&>>);
+
+}// namespace felly_detail
+
+namespace felly::inline lazy_guarded_types {
+
+/** A `T` that is created on first use, then read without locking.
+ *
+ * `get_or_init(f)` creates the value with `f()` if this is the first call;
+ * concurrent callers wait for the first to finish, and `f()` is only called
+ * once. Once initialized, `get_or_init()` and `get()` are a single acquire
+ * load, and never lock the mutex.
+ *
+ * `lock()` returns a `unique_guarded_data_lock<const T>`, which is empty if
+ * the value has not been initialized yet. This is serialized with other
+ * `lock()` calls and initialization, e.g. to wait for an initialization in
+ * progress on another thread. It only gives `const` access: readers that use
+ * `get_or_init()` or `get()` do not lock, so any modification would race with
+ * them. For values that change after initialization, use `guarded_data`.
+ *
+ * If `f()` throws, the value is not initialized, and the next call to
+ * `get_or_init()` will try again.
+ */
+template <class T, class TMutex = std::mutex>
+class lazy_guarded {
+  static_assert(!std::is_const_v<T>);
+
+ public:
+  using mutex_type = TMutex;
+
+  lazy_guarded() = default;
+  lazy_guarded(const lazy_guarded&) = delete;
+  lazy_guarded& operator=(const lazy_guarded&) = delete;
+
+  template <felly_detail::lazy_guarded_initializer<T> F>
+  [[nodiscard]]
+  const T& get_or_init(F&& f) {
+    if (const auto value = mValue.load(std::memory_order_acquire)) [[likely]] {
+      return *value;
+    }
+    return init(f);
+  }
+
+  /// Returns `nullptr` if the value has not been initialized
+  [[nodiscard]]
+  const T* get() const noexcept {
+    return mValue.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]]
+  unique_guarded_data_lock<const T, TMutex> lock() const {
+    std::unique_lock lock {access::mutex(mStorage)};
+    const auto& storage = *access::data(mStorage);
+    return {std::move(lock), storage ? std::addressof(*storage) : nullptr};
+  }
+
+ private:
+  using access = felly_detail::guarded_data_access;
+
+  guarded_data<std::optional<T>, TMutex> mStorage;
+  // Published after `mStorage` is initialized
+  std::atomic<const T*> mValue {nullptr};
+
+  template <class F>
+  FELLY_COLD FELLY_NOINLINE const T& init(F& f) {
+    auto storage = mStorage.lock();
+    if (!storage->has_value()) {
+      using result_type = std::remove_cv_t<std::invoke_result_t<F&>>;
+      if constexpr (
+        std::same_as<result_type, T> && !std::move_constructible<T>) {
+        storage->emplace(felly_detail::lazy_guarded_result<F> {f});
+      } else {
+        storage->emplace(std::invoke(f));
+      }
+      mValue.store(std::addressof(**storage), std::memory_order_release);
+    }
+    return **storage;
+  }
+};
+
+}// namespace felly::inline lazy_guarded_types
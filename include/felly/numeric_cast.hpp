@@ -2,74 +2,115 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "cold.hpp"
+#include "error_policy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <cmath>
 #include <concepts>
-#include <format>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <variant>
 
 namespace felly::inline numeric_cast_types {
 
-struct numeric_cast_range_error : std::range_error {
-  using range_error::range_error;
-
-  template <class T>
-  numeric_cast_range_error(std::type_identity<T>, const auto value)
-    : std::range_error(
-        std::format(
-          "Value {} out of range {}..{}",
-          value,
-          std::numeric_limits<T>::lowest(),
-          std::numeric_limits<T>::max())) {}
+enum class numeric_cast_error {
+  TooLow,
+  TooHigh,
+  // Only for conversions to integral types
+  NaN,
 };
 
-template <std::integral T>
+}// namespace felly::inline numeric_cast_types
+
+/** Rounding modes for floating-point to integral `numeric_cast()`s.
+ *
+ * These are independent of the current floating-point environment, e.g.
+ * `std::fesetround()`.
+ */
+namespace felly::inline numeric_cast_types::rounding {
+
+// Ties to even, e.g. `2.5` to `2`, and `3.5` to `4`
+struct nearest_even_t {
+  explicit nearest_even_t() = default;
+};
+inline constexpr nearest_even_t nearest_even {};
+
+// Ties away from zero, like `std::round()`
+struct nearest_away_t {
+  explicit nearest_away_t() = default;
+};
+inline constexpr nearest_away_t nearest_away {};
+
+struct floor_t {
+  explicit floor_t() = default;
+};
+inline constexpr floor_t floor {};
+
+struct ceil_t {
+  explicit ceil_t() = default;
+};
+inline constexpr ceil_t ceil {};
+
+// The default behavior of `numeric_cast()` and `static_cast()`; in both, the
+// range check applies to the truncated value
+struct truncate_t {
+  explicit truncate_t() = default;
+};
+inline constexpr truncate_t truncate {};
+
+}// namespace felly::inline numeric_cast_types::rounding
+
+namespace felly_detail {
+
+template <class T>
+concept arithmetic = std::integral<T> || std::floating_point<T>;
+
+// The `numeric_cast_in_range()` overloads are free of side effects and early
+// returns, so that they can be vectorized by the range overloads
+
+template <std::integral T, std::integral U>
 [[nodiscard]]
-constexpr T numeric_cast(const std::integral auto v) {
-  if (!std::in_range<T>(v)) [[unlikely]] {
-    throw numeric_cast_range_error(std::type_identity<T> {}, v);
-  }
-  return static_cast<T>(v);
+constexpr bool numeric_cast_in_range(const U v) noexcept {
+  return std::cmp_greater_equal(v, std::numeric_limits<T>::lowest())
+    & std::cmp_less_equal(v, std::numeric_limits<T>::max());
 }
 
+// NaN is in range; it is converted to a NaN of the target type
 template <std::floating_point T, std::floating_point U>
 [[nodiscard]]
-constexpr T numeric_cast(const U u) {
-  if (std::isnan(u)) {
-    return static_cast<T>(u);
-  }
-
+constexpr bool numeric_cast_in_range(const U u) noexcept {
   using V = std::common_type_t<T, U>;
   const auto v = static_cast<V>(u);
 
   constexpr auto Lowest = static_cast<V>(std::numeric_limits<T>::lowest());
   constexpr auto Max = static_cast<V>(std::numeric_limits<T>::max());
 
-  if (v < Lowest || v > Max) [[unlikely]] {
-    throw numeric_cast_range_error(std::type_identity<T> {}, v);
-  }
-  return static_cast<T>(v);
+  return !((v < Lowest) | (v > Max));
 }
 
 template <std::floating_point T, std::integral U>
 [[nodiscard]]
-constexpr T numeric_cast(const U u) {
+constexpr bool numeric_cast_in_range(const U u) noexcept {
   constexpr auto Lowest = std::numeric_limits<T>::lowest();
   constexpr auto Max = std::numeric_limits<T>::max();
-  if (u < Lowest || u > Max) [[unlikely]] {
-    throw numeric_cast_range_error(std::type_identity<T> {}, u);
-  }
-  return static_cast<T>(u);
+  return !((u < Lowest) | (u > Max));
 }
 
+// The smallest power of two that is too large for `T`
 template <std::integral T, std::floating_point U>
-[[nodiscard]]
-constexpr T numeric_cast(const U u) {
-  if (std::isnan(u)) [[unlikely]] {
-    throw numeric_cast_range_error("Can't convert NaN to an integral type");
-  }
-
-  constexpr auto Lowest = static_cast<U>(std::numeric_limits<T>::lowest());
+constexpr U numeric_cast_too_high() noexcept {
   // - Not directly comparing to `max()` to avoid precision loss issues
   // - Not using std::ldexp as while it's constexpr in C++23, it's not constexpr
   //   in MSVC 2022 C++23:
@@ -84,22 +125,552 @@ constexpr T numeric_cast(const U u) {
   // > bug-compatibility).
   //
   // If MSVC chooses bug-compatibility, the standard version may be unusable
-  constexpr auto TooHigh = [] constexpr {
-    auto exponent = std::numeric_limits<T>::digits;
-    U result = 1.0;
-    U base = 2.0;
-    while (exponent > 0) {
-      if ((exponent % 2) != 0) result *= base;
-      base *= base;
-      exponent /= 2;
+  auto exponent = std::numeric_limits<T>::digits;
+  U result = 1.0;
+  U base = 2.0;
+  while (exponent > 0) {
+    if ((exponent % 2) != 0) result *= base;
+    base *= base;
+    exponent /= 2;
+  }
+  return result;
+}
+
+// Checks the truncated value, like `static_cast()`, e.g. `-0.5` is in range
+// for unsigned types.
+//
+// NaN is out of range, as all comparisons with NaN are false
+template <std::integral T, std::floating_point U>
+[[nodiscard]]
+constexpr bool numeric_cast_in_range(const U u) noexcept {
+  constexpr auto Lowest = static_cast<U>(std::numeric_limits<T>::lowest());
+  constexpr auto TooHigh = numeric_cast_too_high<T, U>();
+  // If `lowest() - 1` is not representable, neither is anything between it
+  // and `lowest()`
+  constexpr auto TooLow = Lowest - U {1};
+  if constexpr (TooLow == Lowest) {
+    return (u >= Lowest) & (u < TooHigh);
+  } else {
+    return (u > TooLow) & (u < TooHigh);
+  }
+}
+
+template <class T>
+concept rounding_mode = std::same_as<T, felly::rounding::nearest_even_t>
+  || std::same_as<T, felly::rounding::nearest_away_t>
+  || std::same_as<T, felly::rounding::floor_t>
+  || std::same_as<T, felly::rounding::ceil_t>
+  || std::same_as<T, felly::rounding::truncate_t>;
+
+template <std::floating_point U>
+[[nodiscard]]
+constexpr U numeric_cast_trunc(const U u) noexcept {
+  if !consteval {
+    return std::trunc(u);
+  }
+  // Every value with a magnitude of at least 2^(digits - 1) is an integer;
+  // capped at 2^63 so that smaller values fit in an `std::intmax_t`
+  constexpr auto Integral = [] {
+    U ret = 1;
+    for (auto i = 1; i < std::min(std::numeric_limits<U>::digits, 64); ++i) {
+      ret *= 2;
     }
-    return result;
+    return ret;
   }();
+  if (!(u < Integral && u > -Integral)) {
+    // Already an integer, infinity, or NaN
+    return u;
+  }
+  return static_cast<U>(static_cast<std::intmax_t>(u));
+}
+
+// Round to an integral value, without depending on the floating-point
+// environment, and without branches so that range overloads can be vectorized
+template <rounding_mode R, std::floating_point U>
+[[nodiscard]]
+constexpr U numeric_cast_round(const U u) noexcept {
+  using namespace felly::rounding;
+
+  const auto t = numeric_cast_trunc(u);
+  if constexpr (std::same_as<R, truncate_t>) {
+    return t;
+  } else {
+    // Exact, as `t` has the same sign and exponent as `u`, or is 0
+    const auto fraction = u - t;
+    // Adding or subtracting the results of comparisons instead of selecting
+    // between values, as GCC will not vectorize selections between
+    // floating-point operations that could trap
+    if constexpr (std::same_as<R, floor_t>) {
+      return t - static_cast<U>(fraction < 0);
+    } else if constexpr (std::same_as<R, ceil_t>) {
+      return t + static_cast<U>(fraction > 0);
+    } else {
+      const auto sign = U {1} - (U {2} * static_cast<U>(u < 0));
+      const auto magnitude = sign * fraction;
+      if constexpr (std::same_as<R, nearest_away_t>) {
+        return t + (sign * static_cast<U>(magnitude >= U {0.5}));
+      } else {
+        static_assert(std::same_as<R, nearest_even_t>);
+        const auto half = t * U {0.5};
+        const auto odd = numeric_cast_trunc(half) != half;
+        const auto round_away
+          = (magnitude > U {0.5}) | ((magnitude == U {0.5}) & odd);
+        return t + (sign * static_cast<U>(round_away));
+      }
+    }
+  }
+}
+
+// Branch-free so that the range overloads of `saturate_cast()` can be
+// vectorized
+template <class T, class U>
+[[nodiscard]]
+constexpr T numeric_cast_saturate(const U u, const T nanValue) noexcept {
+  constexpr auto Lowest = std::numeric_limits<T>::lowest();
+  constexpr auto Max = std::numeric_limits<T>::max();
+  if constexpr (std::integral<T> && std::integral<U>) {
+    const auto low = std::cmp_less(u, Lowest);
+    const auto high = std::cmp_greater(u, Max);
+    return low ? Lowest : (high ? Max : static_cast<T>(u));
+  } else if constexpr (std::integral<T>) {
+    const auto nan = std::isnan(u);
+    const auto low = u < static_cast<U>(Lowest);
+    // True for NaN
+    const auto high = !(u < numeric_cast_too_high<T, U>());
+    // Converting out-of-range values is undefined behavior, so replace them
+    // before converting, then select the saturated result
+    const auto converted = static_cast<T>((low | high) ? U {0} : u);
+    return nan ? nanValue : (low ? Lowest : (high ? Max : converted));
+  } else {
+    // NaN compares false, so is converted to a NaN of the target type
+    using V = std::common_type_t<T, U>;
+    constexpr auto VLowest = static_cast<V>(Lowest);
+    constexpr auto VMax = static_cast<V>(Max);
+    const auto v = static_cast<V>(u);
+    const auto notLow = (v < VLowest) ? VLowest : v;
+    return static_cast<T>((notLow > VMax) ? VMax : notLow);
+  }
+}
+
+template <class T, class R>
+constexpr void numeric_cast_saturate_range(
+  R& in,
+  const std::span<T> out,
+  const T nanValue) {
+  const auto size = std::ranges::size(in);
+  if (FELLY_CHECK_FAILED(size == out.size())) [[unlikely]] {
+    raise_error<std::invalid_argument>(
+      "saturate_cast() input and output sizes differ");
+  }
+
+  const auto data = std::ranges::data(in);
+  for (std::size_t i = 0; i < size; ++i) {
+    out[i] = numeric_cast_saturate<T>(data[i], nanValue);
+  }
+}
+
+// Why `numeric_cast_in_range<T>(u)` is false
+template <class T, class U>
+[[nodiscard]]
+constexpr felly::numeric_cast_error numeric_cast_failure(const U u) noexcept {
+  using enum felly::numeric_cast_error;
+  if constexpr (std::floating_point<U>) {
+    if (std::isnan(u)) {
+      return NaN;
+    }
+  }
+  constexpr auto Lowest = std::numeric_limits<T>::lowest();
+  if constexpr (std::integral<T> && std::integral<U>) {
+    return std::cmp_less(u, Lowest) ? TooLow : TooHigh;
+  } else {
+    using V = std::common_type_t<T, U>;
+    return (static_cast<V>(u) < static_cast<V>(Lowest)) ? TooLow : TooHigh;
+  }
+}
+
+using numeric_cast_value_type
+  = std::variant<std::intmax_t, std::uintmax_t, double>;
+
+template <arithmetic T>
+constexpr numeric_cast_value_type numeric_cast_value(const T value) noexcept {
+  if constexpr (std::floating_point<T>) {
+    return static_cast<double>(value);
+  } else if constexpr (std::signed_integral<T>) {
+    return static_cast<std::intmax_t>(value);
+  } else {
+    return static_cast<std::uintmax_t>(value);
+  }
+}
+
+// Uses `std::to_chars()` instead of `std::format()` to keep `<format>` out of
+// every translation unit that includes this header; output that does not fit
+// is truncated.
+class numeric_cast_message_writer {
+ public:
+  explicit numeric_cast_message_writer(const std::span<char> buffer) noexcept
+    : mIt(buffer.data()),
+      // Leave space for the trailing null
+      mEnd(buffer.data() + buffer.size() - 1) {}
+
+  ~numeric_cast_message_writer() {
+    *mIt = '\0';
+  }
+
+  numeric_cast_message_writer(const numeric_cast_message_writer&) = delete;
+  numeric_cast_message_writer& operator=(const numeric_cast_message_writer&)
+    = delete;
+
+  void operator()(const std::string_view v) noexcept {
+    const auto count = std::min<std::size_t>(v.size(), mEnd - mIt);
+    mIt = std::copy_n(v.data(), count, mIt);
+  }
+
+  void operator()(const arithmetic auto v) noexcept {
+    const auto [ptr, ec] = std::to_chars(mIt, mEnd, v);
+    if (ec == std::errc {}) {
+      mIt = ptr;
+    }
+  }
+
+  void operator()(const numeric_cast_value_type& v) noexcept {
+    std::visit(*this, v);
+  }
+
+ private:
+  char* mIt;
+  char* mEnd;
+};
+
+FELLY_COLD inline void numeric_cast_format_message(
+  const std::span<char> buffer,
+  const std::optional<std::size_t> index,
+  const felly::numeric_cast_error reason,
+  const numeric_cast_value_type& value,
+  const numeric_cast_value_type& lowest,
+  const numeric_cast_value_type& max) noexcept {
+  numeric_cast_message_writer write {buffer};
+  using namespace std::string_view_literals;
+
+  if (index) {
+    write("Element "sv);
+    write(*index);
+    write(": "sv);
+  }
+  if (reason == felly::numeric_cast_error::NaN) {
+    write("Can't convert NaN to an integral type"sv);
+  } else {
+    write("Value "sv);
+    write(value);
+    write(" out of range "sv);
+    write(lowest);
+    write(".."sv);
+    write(max);
+  }
+}
+
+}// namespace felly_detail
 
-  if (u < Lowest || u >= TooHigh) [[unlikely]] {
-    throw numeric_cast_range_error(std::type_identity<T> {}, u);
+namespace felly::inline numeric_cast_types {
+
+/** Thrown by `numeric_cast()`.
+ *
+ * The message is formatted when the exception is constructed, which only
+ * happens in out-of-line cold functions, not at each call site.
+ */
+struct numeric_cast_range_error : std::range_error {
+  using value_type = felly_detail::numeric_cast_value_type;
+
+  template <class T, class U>
+  numeric_cast_range_error(std::type_identity<T>, const U value)
+    : numeric_cast_range_error(
+        felly_detail::numeric_cast_failure<T>(value),
+        felly_detail::numeric_cast_value(value),
+        felly_detail::numeric_cast_value(std::numeric_limits<T>::lowest()),
+        felly_detail::numeric_cast_value(std::numeric_limits<T>::max())) {}
+
+  FELLY_COLD numeric_cast_range_error(
+    const numeric_cast_error reason,
+    const value_type& value,
+    const value_type& lowest,
+    const value_type& max)
+    : std::range_error("numeric_cast() value out of range"),
+      mReason(reason),
+      mValue(value),
+      mLowest(lowest),
+      mMax(max) {
+    felly_detail::numeric_cast_format_message(
+      mMessage, std::nullopt, reason, value, lowest, max);
+  }
+
+  [[nodiscard]]
+  const char* what() const noexcept override {
+    return mMessage.data();
+  }
+
+  [[nodiscard]]
+  numeric_cast_error reason() const noexcept {
+    return mReason;
+  }
+
+  [[nodiscard]]
+  const value_type& value() const noexcept {
+    return mValue;
+  }
+
+  /// The lowest value of the target type
+  [[nodiscard]]
+  const value_type& lowest() const noexcept {
+    return mLowest;
+  }
+
+  /// The maximum value of the target type
+  [[nodiscard]]
+  const value_type& max() const noexcept {
+    return mMax;
+  }
+
+ protected:
+  numeric_cast_error mReason;
+  value_type mValue;
+  value_type mLowest;
+  value_type mMax;
+  std::array<char, 192> mMessage {};
+};
+
+/// Thrown by the range overloads of `numeric_cast()`
+struct numeric_cast_element_error : numeric_cast_range_error {
+  FELLY_COLD numeric_cast_element_error(
+    const std::size_t index,
+    const numeric_cast_range_error& error)
+    : numeric_cast_range_error(error),
+      mIndex(index) {
+    felly_detail::numeric_cast_format_message(
+      mMessage, index, mReason, mValue, mLowest, mMax);
+  }
+
+  [[nodiscard]]
+  std::size_t index() const noexcept {
+    return mIndex;
+  }
+
+ private:
+  std::size_t mIndex;
+};
+
+}// namespace felly::inline numeric_cast_types
+
+namespace felly_detail {
+
+template <class T, class U>
+[[noreturn]] FELLY_COLD FELLY_NOINLINE void throw_numeric_cast_error(
+  const U value) {
+  raise_error<felly::numeric_cast_range_error>(std::type_identity<T> {}, value);
+}
+
+template <class T, class U>
+[[noreturn]] FELLY_COLD FELLY_NOINLINE void throw_numeric_cast_element_error(
+  const std::size_t index,
+  const U value) {
+  raise_error<felly::numeric_cast_element_error>(
+    index, felly::numeric_cast_range_error(std::type_identity<T> {}, value));
+}
+
+// `transform` is applied before both the range check and the conversion; errors
+// report the original value
+template <class T, class R, class F>
+constexpr void numeric_cast_range(R& in, const std::span<T> out, F transform) {
+  const auto size = std::ranges::size(in);
+  if (FELLY_CHECK_FAILED(size == out.size())) [[unlikely]] {
+    raise_error<std::invalid_argument>(
+      "numeric_cast() input and output sizes differ");
+  }
+
+  const auto data = std::ranges::data(in);
+  constexpr std::size_t BlockSize = 256;
+  for (std::size_t begin = 0; begin < size; begin += BlockSize) {
+    const auto end = std::min(size, begin + BlockSize);
+
+    // Counted instead of `bool &=` as that's more readily vectorized
+    std::size_t invalid = 0;
+    for (auto i = begin; i < end; ++i) {
+      invalid += !numeric_cast_in_range<T>(transform(data[i]));
+    }
+    if (FELLY_CHECK_FAILED(invalid == 0)) [[unlikely]] {
+      for (auto i = begin; i < end; ++i) {
+        if (!numeric_cast_in_range<T>(transform(data[i]))) {
+          throw_numeric_cast_element_error<T>(i, data[i]);
+        }
+      }
+    }
+
+    for (auto i = begin; i < end; ++i) {
+      out[i] = static_cast<T>(transform(data[i]));
+    }
+  }
+}
+
+}// namespace felly_detail
+
+namespace felly::inline numeric_cast_types {
+
+template <std::integral T>
+[[nodiscard]]
+constexpr T numeric_cast(const std::integral auto v) {
+  if (FELLY_CHECK_FAILED(felly_detail::numeric_cast_in_range<T>(v)))
+    [[unlikely]] {
+    felly_detail::throw_numeric_cast_error<T>(v);
+  }
+  return static_cast<T>(v);
+}
+
+template <std::floating_point T, std::floating_point U>
+[[nodiscard]]
+constexpr T numeric_cast(const U u) {
+  if (FELLY_CHECK_FAILED(felly_detail::numeric_cast_in_range<T>(u)))
+    [[unlikely]] {
+    felly_detail::throw_numeric_cast_error<T>(u);
+  }
+  return static_cast<T>(u);
+}
+
+template <std::floating_point T, std::integral U>
+[[nodiscard]]
+constexpr T numeric_cast(const U u) {
+  if (FELLY_CHECK_FAILED(felly_detail::numeric_cast_in_range<T>(u)))
+    [[unlikely]] {
+    felly_detail::throw_numeric_cast_error<T>(u);
+  }
+  return static_cast<T>(u);
+}
+
+template <std::integral T, std::floating_point U>
+[[nodiscard]]
+constexpr T numeric_cast(const U u) {
+  if (FELLY_CHECK_FAILED(felly_detail::numeric_cast_in_range<T>(u)))
+    [[unlikely]] {
+    felly_detail::throw_numeric_cast_error<T>(u);
+  }
+  return static_cast<T>(u);
+}
+
+/** Round, then convert to an integral type.
+ *
+ * For example, `numeric_cast<int>(2.5, rounding::nearest_even)` is `2`. The
+ * range check is applied to the rounded value, so
+ * `numeric_cast<int8_t>(127.4, rounding::nearest_even)` is `127`, but
+ * `numeric_cast<int8_t>(127.4, rounding::ceil)` throws.
+ */
+template <
+  std::integral T,
+  std::floating_point U,
+  felly_detail::rounding_mode TRounding>
+[[nodiscard]]
+constexpr T numeric_cast(const U u, TRounding) {
+  const auto rounded = felly_detail::numeric_cast_round<TRounding>(u);
+  if (FELLY_CHECK_FAILED(felly_detail::numeric_cast_in_range<T>(rounded)))
+    [[unlikely]] {
+    felly_detail::throw_numeric_cast_error<T>(u);
+  }
+  return static_cast<T>(rounded);
+}
+
+/** Like `numeric_cast()`, but returns an error instead of throwing.
+ *
+ * For example, `try_numeric_cast<int32_t>(int64_t {1} << 40)` returns
+ * `std::unexpected {numeric_cast_error::TooHigh}`.
+ */
+template <felly_detail::arithmetic T, felly_detail::arithmetic U>
+[[nodiscard]]
+constexpr std::expected<T, numeric_cast_error> try_numeric_cast(
+  const U u) noexcept {
+  if (!felly_detail::numeric_cast_in_range<T>(u)) [[unlikely]] {
+    return std::unexpected {felly_detail::numeric_cast_failure<T>(u)};
   }
   return static_cast<T>(u);
 }
 
+template <
+  std::integral T,
+  std::floating_point U,
+  felly_detail::rounding_mode TRounding>
+[[nodiscard]]
+constexpr std::expected<T, numeric_cast_error> try_numeric_cast(
+  const U u,
+  TRounding) noexcept {
+  const auto rounded = felly_detail::numeric_cast_round<TRounding>(u);
+  if (!felly_detail::numeric_cast_in_range<T>(rounded)) [[unlikely]] {
+    return std::unexpected {felly_detail::numeric_cast_failure<T>(u)};
+  }
+  return static_cast<T>(rounded);
+}
+
+/** Convert to `T`, clamping out-of-range values to the limits of `T`.
+ *
+ * This uses the same boundaries as `numeric_cast()`, so, for example,
+ * `saturate_cast<int32_t>(2147483647.5)` is `2147483647`.
+ *
+ * When converting floating-point values to integral types, NaN is converted to
+ * `0`; when converting between floating-point types, NaN is preserved.
+ */
+template <felly_detail::arithmetic T, felly_detail::arithmetic U>
+[[nodiscard]]
+constexpr T saturate_cast(const U u) noexcept {
+  return felly_detail::numeric_cast_saturate<T>(u, T {0});
+}
+
+/// Converts NaN to `nan_value` instead of `0`
+template <std::integral T, std::floating_point U>
+[[nodiscard]]
+constexpr T saturate_cast(const U u, const T nan_value) noexcept {
+  return felly_detail::numeric_cast_saturate<T>(u, nan_value);
+}
+
+/** Convert every element of `in`, storing the results in `out`.
+ *
+ * This is equivalent to calling `numeric_cast()` on each element, but first
+ * checks blocks of elements at a time without branching, so that both the
+ * checks and the conversions can be vectorized.
+ *
+ * If any element is out of range, this throws a `numeric_cast_element_error`
+ * for the first such element; `out` may have been partially written.
+ */
+template <felly_detail::arithmetic T, std::ranges::contiguous_range R>
+  requires std::ranges::sized_range<R>
+  && felly_detail::arithmetic<std::ranges::range_value_t<R>>
+constexpr void numeric_cast(R&& in, const std::span<T> out) {
+  felly_detail::numeric_cast_range<T>(in, out, [](const auto u) { return u; });
+}
+
+/// Round and convert every element of `in`, storing the results in `out`
+template <
+  std::integral T,
+  std::ranges::contiguous_range R,
+  felly_detail::rounding_mode TRounding>
+  requires std::ranges::sized_range<R>
+  && std::floating_point<std::ranges::range_value_t<R>>
+constexpr void numeric_cast(R&& in, const std::span<T> out, TRounding) {
+  felly_detail::numeric_cast_range<T>(in, out, [](const auto u) {
+    return felly_detail::numeric_cast_round<TRounding>(u);
+  });
+}
+
+/// `saturate_cast()` every element of `in`, storing the results in `out`
+template <felly_detail::arithmetic T, std::ranges::contiguous_range R>
+  requires std::ranges::sized_range<R>
+  && felly_detail::arithmetic<std::ranges::range_value_t<R>>
+constexpr void saturate_cast(R&& in, const std::span<T> out) {
+  felly_detail::numeric_cast_saturate_range<T>(in, out, T {0});
+}
+
+/// Converts NaN to `nan_value` instead of `0`
+template <std::integral T, std::ranges::contiguous_range R>
+  requires std::ranges::sized_range<R>
+  && std::floating_point<std::ranges::range_value_t<R>>
+constexpr void saturate_cast(
+  R&& in,
+  const std::span<T> out,
+  const T nan_value) {
+  felly_detail::numeric_cast_saturate_range<T>(in, out, nan_value);
+}
+
 }// namespace felly::inline numeric_cast_types
@@ -0,0 +1,409 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "cold.hpp"
+#include "error_policy.hpp"
+#include "numeric_cast.hpp"
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace felly::inline numeric_parse_types {
+
+enum class numeric_parse_error {
+  // Not a number, or has leading or trailing characters
+  Invalid,
+  TooLow,
+  TooHigh,
+  // Only for the delimited overloads
+  TooManyFields,
+};
+
+/// Returned by the delimited overloads of `try_numeric_parse()`
+struct numeric_parse_field_error {
+  std::size_t index {};
+  numeric_parse_error reason {};
+
+  constexpr bool operator==(const numeric_parse_field_error&) const noexcept
+    = default;
+};
+
+}// namespace felly::inline numeric_parse_types
+
+namespace felly_detail {
+
+// `std::from_chars()` does not support `bool`, and libc++ only added
+// floating-point support in LLVM 20
+template <class T>
+concept numeric_parse_type
+  = (std::integral<T> && !std::same_as<std::remove_cv_t<T>, bool>)
+#if __cpp_lib_to_chars >= 201611L
+  || std::floating_point<T>
+#endif
+  ;
+
+// Whether text that `std::from_chars()` fully consumed, but is out of range
+// for a floating-point type, is too large rather than too close to zero.
+inline bool numeric_parse_overflows(std::string_view text) noexcept {
+  if (text.starts_with('-')) {
+    text.remove_prefix(1);
+  }
+
+  // The decimal exponent of the first significant digit, plus one
+  std::int64_t order = 0;
+  bool fraction = false;
+  std::size_t i = 0;
+  for (; i < text.size(); ++i) {
+    if (text[i] == '.') {
+      fraction = true;
+      continue;
+    }
+    if (text[i] != '0') {
+      break;
+    }
+    if (fraction) {
+      --order;
+    }
+  }
+  if (!fraction) {
+    for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+      ++order;
+    }
+  }
+
+  const auto e = text.find_first_of("eE", i);
+  if (e == std::string_view::npos) {
+    return order > 0;
+  }
+  auto exponent = text.substr(e + 1);
+  if (exponent.starts_with('+')) {
+    exponent.remove_prefix(1);
+  }
+  std::int32_t value {};
+  const auto [ptr, ec] = std::from_chars(
+    exponent.data(), exponent.data() + exponent.size(), value);
+  if (ec == std::errc::result_out_of_range) {
+    return !exponent.starts_with('-');
+  }
+  return order + value > 0;
+}
+
+// Classifies a failed `std::from_chars()`
+template <class T>
+FELLY_COLD FELLY_NOINLINE std::expected<T, felly::numeric_parse_error>
+numeric_parse_failure(
+  const std::string_view text,
+  const std::from_chars_result result) noexcept {
+  using enum felly::numeric_parse_error;
+  const auto last = text.data() + text.size();
+  const bool negative = text.starts_with('-');
+
+  if constexpr (std::unsigned_integral<T>) {
+    // `std::from_chars()` rejects the sign for unsigned types
+    if (negative && result.ec == std::errc::invalid_argument) {
+      T magnitude {};
+      const auto [ptr, ec] = std::from_chars(text.data() + 1, last, magnitude);
+      if (ec == std::errc::invalid_argument || ptr != last) {
+        return std::unexpected {Invalid};
+      }
+      if (ec == std::errc {} && magnitude == 0) {
+        return T {0};
+      }
+      return std::unexpected {TooLow};
+    }
+  }
+
+  if (result.ec != std::errc::result_out_of_range || result.ptr != last) {
+    return std::unexpected {Invalid};
+  }
+  if constexpr (std::floating_point<T>) {
+    // Like `numeric_cast()`, values that are too close to zero are not errors
+    if (!numeric_parse_overflows(text)) {
+      return negative ? -T {0} : T {0};
+    }
+  }
+  return std::unexpected {negative ? TooLow : TooHigh};
+}
+
+template <numeric_parse_type T>
+std::expected<T, felly::numeric_parse_error> numeric_parse_value(
+  const std::string_view text) noexcept {
+  const auto last = text.data() + text.size();
+  T value {};
+  const auto result = std::from_chars(text.data(), last, value);
+  if (result.ec == std::errc {} && result.ptr == last) [[likely]] {
+    return value;
+  }
+  return numeric_parse_failure<T>(text, result);
+}
+
+struct numeric_parse_fields_result {
+  std::size_t mCount {};
+  std::optional<felly::numeric_parse_error> mError;
+  // The field that could not be parsed, if any
+  std::string_view mField;
+};
+
+template <class T>
+numeric_parse_fields_result numeric_parse_fields(
+  std::string_view input,
+  const char delimiter,
+  const std::span<T> out) noexcept {
+  if (input.empty()) {
+    return {};
+  }
+  for (std::size_t i = 0;; ++i) {
+    const auto end = input.find(delimiter);
+    const auto field = input.substr(0, end);
+    if (i == out.size()) [[unlikely]] {
+      return {i, felly::numeric_parse_error::TooManyFields, field};
+    }
+    const auto value = numeric_parse_value<T>(field);
+    if (!value) [[unlikely]] {
+      return {i, value.error(), field};
+    }
+    out[i] = *value;
+    if (end == std::string_view::npos) {
+      return {i + 1, std::nullopt, {}};
+    }
+    input.remove_prefix(end + 1);
+  }
+}
+
+FELLY_COLD inline void numeric_parse_format_message(
+  const std::span<char> buffer,
+  const std::optional<std::size_t> field,
+  const std::string_view text,
+  const felly::numeric_parse_error reason,
+  const numeric_cast_value_type& lowest,
+  const numeric_cast_value_type& max) noexcept {
+  constexpr std::size_t MaxTextLength = 32;
+  numeric_cast_message_writer write {buffer};
+  using namespace std::string_view_literals;
+
+  if (field) {
+    write("Field "sv);
+    write(*field);
+    write(": "sv);
+  }
+  write(reason == felly::numeric_parse_error::Invalid ? "Can't parse '"sv
+                                                      : "Value '"sv);
+  write(text.substr(0, MaxTextLength));
+  write(text.size() > MaxTextLength ? "...'"sv : "'"sv);
+  if (reason == felly::numeric_parse_error::Invalid) {
+    write(" as a number"sv);
+  } else {
+    write(" out of range "sv);
+    write(lowest);
+    write(".."sv);
+    write(max);
+  }
+}
+
+}// namespace felly_detail
+
+namespace felly::inline numeric_parse_types {
+
+/// Thrown by `numeric_parse()` if the text is not a number, or has leading or
+/// trailing characters
+struct numeric_parse_invalid_argument : std::invalid_argument {
+  FELLY_COLD numeric_parse_invalid_argument(
+    const std::optional<std::size_t> field,
+    const std::string_view text)
+    : std::invalid_argument("numeric_parse() invalid argument"),
+      mField(field) {
+    felly_detail::numeric_parse_format_message(
+      mMessage, field, text, numeric_parse_error::Invalid, {}, {});
+  }
+
+  [[nodiscard]]
+  const char* what() const noexcept override {
+    return mMessage.data();
+  }
+
+  /// The index of the field, for the delimited overloads
+  [[nodiscard]]
+  std::optional<std::size_t> field() const noexcept {
+    return mField;
+  }
+
+ private:
+  std::optional<std::size_t> mField;
+  std::array<char, 192> mMessage {};
+};
+
+/// Thrown by `numeric_parse()` if the number does not fit in the target type
+struct numeric_parse_range_error : std::range_error {
+  using value_type = felly_detail::numeric_cast_value_type;
+
+  template <class T>
+  numeric_parse_range_error(
+    std::type_identity<T>,
+    const std::optional<std::size_t> field,
+    const std::string_view text,
+    const numeric_parse_error reason)
+    : numeric_parse_range_error(
+        field,
+        text,
+        reason,
+        felly_detail::numeric_cast_value(std::numeric_limits<T>::lowest()),
+        felly_detail::numeric_cast_value(std::numeric_limits<T>::max())) {}
+
+  FELLY_COLD numeric_parse_range_error(
+    const std::optional<std::size_t> field,
+    const std::string_view text,
+    const numeric_parse_error reason,
+    const value_type& lowest,
+    const value_type& max)
+    : std::range_error("numeric_parse() value out of range"),
+      mField(field),
+      mReason(reason),
+      mLowest(lowest),
+      mMax(max) {
+    felly_detail::numeric_parse_format_message(
+      mMessage, field, text, reason, lowest, max);
+  }
+
+  [[nodiscard]]
+  const char* what() const noexcept override {
+    return mMessage.data();
+  }
+
+  /// The index of the field, for the delimited overloads
+  [[nodiscard]]
+  std::optional<std::size_t> field() const noexcept {
+    return mField;
+  }
+
+  /// `TooLow` or `TooHigh`
+  [[nodiscard]]
+  numeric_parse_error reason() const noexcept {
+    return mReason;
+  }
+
+  /// The lowest value of the target type
+  [[nodiscard]]
+  const value_type& lowest() const noexcept {
+    return mLowest;
+  }
+
+  /// The maximum value of the target type
+  [[nodiscard]]
+  const value_type& max() const noexcept {
+    return mMax;
+  }
+
+ private:
+  std::optional<std::size_t> mField;
+  numeric_parse_error mReason;
+  value_type mLowest;
+  value_type mMax;
+  std::array<char, 192> mMessage {};
+};
+
+}// namespace felly::inline numeric_parse_types
+
+namespace felly_detail {
+
+template <class T>
+[[noreturn]] FELLY_COLD FELLY_NOINLINE void throw_numeric_parse_error(
+  const std::optional<std::size_t> field,
+  const std::string_view text,
+  const felly::numeric_parse_error reason) {
+  using enum felly::numeric_parse_error;
+  switch (reason) {
+    case Invalid:
+      raise_error<felly::numeric_parse_invalid_argument>(field, text);
+    case TooLow:
+    case TooHigh:
+      raise_error<felly::numeric_parse_range_error>(
+        std::type_identity<T> {}, field, text, reason);
+    case TooManyFields:
+      break;
+  }
+  raise_error<std::invalid_argument>(
+    "numeric_parse() input has more fields than output elements");
+}
+
+}// namespace felly_detail
+
+namespace felly::inline numeric_parse_types {
+
+/** Parse the entire string as a `T`; does not allocate.
+ *
+ * This is `std::from_chars()` directly into the target type, so leading
+ * whitespace or `+` are invalid, and integers are base-10. Floating-point text
+ * may also be `inf` or `nan`; floating-point values that are too close to zero
+ * are parsed as zero, like `numeric_cast()`.
+ */
+template <felly_detail::numeric_parse_type T>
+[[nodiscard]]
+std::expected<T, numeric_parse_error> try_numeric_parse(
+  const std::string_view text) noexcept {
+  return felly_detail::numeric_parse_value<T>(text);
+}
+
+/// Like `try_numeric_parse()`, but throws a `numeric_parse_invalid_argument`
+/// or `numeric_parse_range_error`
+template <felly_detail::numeric_parse_type T>
+[[nodiscard]]
+T numeric_parse(const std::string_view text) {
+  const auto ret = felly_detail::numeric_parse_value<T>(text);
+  if (!ret) [[unlikely]] {
+    felly_detail::throw_numeric_parse_error<T>(std::nullopt, text, ret.error());
+  }
+  return *ret;
+}
+
+/** Parse each `delimiter`-separated field of `input` into `out`.
+ *
+ * Returns the subspan of `out` that was written; empty input has no fields,
+ * but empty fields are invalid. Stops at the first invalid field, which may
+ * be after some of `out` has been written.
+ */
+template <felly_detail::numeric_parse_type T>
+[[nodiscard]]
+std::expected<std::span<T>, numeric_parse_field_error> try_numeric_parse(
+  const std::string_view input,
+  const char delimiter,
+  const std::span<T> out) noexcept {
+  const auto result = felly_detail::numeric_parse_fields(input, delimiter, out);
+  if (result.mError) [[unlikely]] {
+    return std::unexpected {
+      numeric_parse_field_error {result.mCount, *result.mError}};
+  }
+  return out.first(result.mCount);
+}
+
+/** Like the delimited `try_numeric_parse()`, but throws on failure.
+ *
+ * The errors have a `field()`; if there are more fields than `out` has space
+ * for, `std::invalid_argument` is thrown.
+ */
+template <felly_detail::numeric_parse_type T>
+[[nodiscard]]
+std::span<T> numeric_parse(
+  const std::string_view input,
+  const char delimiter,
+  const std::span<T> out) {
+  const auto result = felly_detail::numeric_parse_fields(input, delimiter, out);
+  if (result.mError) [[unlikely]] {
+    felly_detail::throw_numeric_parse_error<T>(
+      result.mCount, result.mField, *result.mError);
+  }
+  return out.first(result.mCount);
+}
+
+}// namespace felly::inline numeric_parse_types
@@ -0,0 +1,239 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "adaptive_mutex.hpp"
+#include "error_policy.hpp"
+#include "unique_ptr.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace felly_detail {
+
+template <class T>
+union object_pool_node {
+  object_pool_node* mNext;
+  alignas(T) std::byte mStorage[sizeof(T)];
+};
+
+// Free nodes shared between threads
+template <class T>
+struct object_pool_shared_list {
+  using node_type = object_pool_node<T>;
+
+  felly::adaptive_mutex mMutex;
+  node_type* mHead {nullptr};
+
+  // Never destroyed, so that objects can be returned to the pool during
+  // static destruction
+  static object_pool_shared_list& get() noexcept {
+    static auto* const instance = new object_pool_shared_list();
+    return *instance;
+  }
+
+  // `first` to `last` must already be linked
+  void push(node_type* const first, node_type* const last) noexcept {
+    std::unique_lock lock {mMutex};
+    last->mNext = mHead;
+    mHead = first;
+  }
+
+  // Returns the first node, linked to at most `count - 1` more
+  [[nodiscard]]
+  node_type* pop(const std::size_t count) noexcept {
+    std::unique_lock lock {mMutex};
+    auto first = mHead;
+    if (!first) {
+      return nullptr;
+    }
+    auto last = first;
+    for (std::size_t i = 1; i < count && last->mNext; ++i) {
+      last = last->mNext;
+    }
+    mHead = std::exchange(last->mNext, nullptr);
+    return first;
+  }
+
+  [[nodiscard]]
+  node_type* take_all() noexcept {
+    std::unique_lock lock {mMutex};
+    return std::exchange(mHead, nullptr);
+  }
+};
+
+template <class T, std::size_t TCapacity>
+struct object_pool_thread_cache {
+  using node_type = object_pool_node<T>;
+
+  node_type* mHead {nullptr};
+  std::size_t mSize {0};
+
+  // Set when the thread is exiting; later allocations and frees use the
+  // shared list. This is trivially destructible, so unlike the cache, it is
+  // still valid while other thread_locals are being destroyed.
+  static constinit inline thread_local bool tDestroyed {false};
+
+  object_pool_thread_cache() = default;
+  object_pool_thread_cache(const object_pool_thread_cache&) = delete;
+  object_pool_thread_cache& operator=(const object_pool_thread_cache&)
+    = delete;
+
+  ~object_pool_thread_cache() {
+    flush();
+    tDestroyed = true;
+  }
+
+  // Returns nullptr if the thread's cache has been destroyed
+  [[nodiscard]]
+  static object_pool_thread_cache* get() noexcept {
+    if (tDestroyed) [[unlikely]] {
+      return nullptr;
+    }
+    thread_local object_pool_thread_cache instance;
+    return &instance;
+  }
+
+  [[nodiscard]]
+  static node_type* pop_any() noexcept {
+    if (const auto cache = get()) [[likely]] {
+      return cache->pop();
+    }
+    return object_pool_shared_list<T>::get().pop(1);
+  }
+
+  static void push_any(node_type* const node) noexcept {
+    if (const auto cache = get()) [[likely]] {
+      cache->push(node);
+      return;
+    }
+    object_pool_shared_list<T>::get().push(node, node);
+  }
+
+  void flush() noexcept {
+    if (!mHead) {
+      return;
+    }
+    auto last = mHead;
+    while (last->mNext) {
+      last = last->mNext;
+    }
+    object_pool_shared_list<T>::get().push(std::exchange(mHead, nullptr), last);
+    mSize = 0;
+  }
+
+  [[nodiscard]]
+  node_type* pop() noexcept {
+    if (!mHead) [[unlikely]] {
+      // Take half of the capacity, to leave space for frees without
+      // immediately returning nodes to the shared list
+      mHead = object_pool_shared_list<T>::get().pop(TCapacity / 2);
+      for (auto it = mHead; it; it = it->mNext) {
+        ++mSize;
+      }
+      if (!mHead) {
+        return nullptr;
+      }
+    }
+    --mSize;
+    return std::exchange(mHead, mHead->mNext);
+  }
+
+  void push(node_type* const node) noexcept {
+    if (mSize == TCapacity) [[unlikely]] {
+      // Return half of the nodes to the shared list
+      auto last = mHead;
+      for (std::size_t i = 1; i < TCapacity / 2; ++i) {
+        last = last->mNext;
+      }
+      object_pool_shared_list<T>::get().push(
+        std::exchange(mHead, std::exchange(last->mNext, nullptr)), last);
+      mSize -= TCapacity / 2;
+    }
+    node->mNext = std::exchange(mHead, node);
+    ++mSize;
+  }
+};
+
+}// namespace felly_detail
+
+namespace felly::inline object_pool_types {
+
+/** A per-type pool of storage for `T`s, used by `make_pooled()`.
+ *
+ * Each thread caches up to `ThreadCacheCapacity` free objects, which are
+ * reused without locking; beyond that, or when the thread exits, free
+ * storage is moved in batches to a list that is shared by all threads.
+ *
+ * Objects may be destroyed on a different thread than they were created on.
+ * Storage is not returned to the system unless `trim()` is called.
+ */
+template <class T>
+  requires std::is_object_v<T> && (!std::is_array_v<T>)
+  && std::is_nothrow_destructible_v<T>
+class object_pool {
+ public:
+  static constexpr std::size_t ThreadCacheCapacity = 64;
+
+  object_pool() = delete;
+
+  /// Construct a `T` in pooled storage
+  template <class... Args>
+    requires std::constructible_from<T, Args&&...>
+  [[nodiscard]]
+  static T* create(Args&&... args) {
+    auto node = thread_cache::pop_any();
+    if (!node) {
+      node = new node_type;
+    }
+#if FELLY_HAS_EXCEPTIONS
+    try {
+      return std::construct_at(
+        reinterpret_cast<T*>(node->mStorage), std::forward<Args>(args)...);
+    } catch (...) {
+      thread_cache::push_any(node);
+      throw;
+    }
+#else
+    return std::construct_at(
+      reinterpret_cast<T*>(node->mStorage), std::forward<Args>(args)...);
+#endif
+  }
+
+  /// Destroy an object from `create()`, and return its storage to the pool
+  static void destroy(T* const p) noexcept {
+    std::destroy_at(p);
+    thread_cache::push_any(reinterpret_cast<node_type*>(p));
+  }
+
+  /// Free the calling thread's cached storage, and all shared storage
+  static void trim() noexcept {
+    if (const auto cache = thread_cache::get()) {
+      cache->flush();
+    }
+    auto node = felly_detail::object_pool_shared_list<T>::get().take_all();
+    while (node) {
+      delete std::exchange(node, node->mNext);
+    }
+  }
+
+ private:
+  using node_type = felly_detail::object_pool_node<T>;
+  using thread_cache
+    = felly_detail::object_pool_thread_cache<T, ThreadCacheCapacity>;
+};
+
+/// A `felly::unique_ptr` that returns its object to the `object_pool<T>`
+template <class T>
+using pooled_ptr = unique_ptr<T, &object_pool<T>::destroy>;
+
+template <class T, class... Args>
+[[nodiscard]]
+pooled_ptr<T> make_pooled(Args&&... args) {
+  return pooled_ptr<T> {object_pool<T>::create(std::forward<Args>(args)...)};
+}
+
+}// namespace felly::inline object_pool_types
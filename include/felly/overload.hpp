@@ -2,6 +2,16 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "error_policy.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
 namespace felly::inline overload_types {
 
 /// Allows `std::visit()` on a variant with exhaustiveness checks
@@ -11,3 +21,134 @@ struct overload : Ts... {
 };
 
 }// namespace felly::inline overload_types
+
+namespace felly_detail {
+
+template <class V>
+concept overload_variant = requires {
+  std::variant_size<std::remove_cvref_t<V>>::value;
+};
+
+// `std::get()`, without the index check
+template <std::size_t I, class V>
+constexpr decltype(auto) overload_get(V&& v) noexcept {
+  const auto p = std::get_if<I>(std::addressof(v));
+  if constexpr (std::is_lvalue_reference_v<V>) {
+    return *p;
+  } else {
+    return std::move(*p);
+  }
+}
+
+template <class V, std::size_t I = 0>
+using overload_alternative_t = decltype(overload_get<I>(std::declval<V>()));
+
+// Number of cases in each generated `switch`; larger variants are handled in
+// chunks
+inline constexpr std::size_t OverloadSwitchSize = 16;
+
+// Invokes `f(std::integral_constant<std::size_t, I>)` where `I == index`
+template <class R, std::size_t N, std::size_t Offset = 0, class F>
+constexpr R overload_switch(const std::size_t index, F& f) {
+  static_assert(OverloadSwitchSize == 16, "Cases must match the size");
+#define FELLY_OVERLOAD_CASE(I) \
+  case Offset + I: \
+    if constexpr (Offset + I < N) { \
+      return f(std::integral_constant<std::size_t, Offset + I> {}); \
+    } else { \
+      std::unreachable(); \
+    }
+  switch (index) {
+    FELLY_OVERLOAD_CASE(0)
+    FELLY_OVERLOAD_CASE(1)
+    FELLY_OVERLOAD_CASE(2)
+    FELLY_OVERLOAD_CASE(3)
+    FELLY_OVERLOAD_CASE(4)
+    FELLY_OVERLOAD_CASE(5)
+    FELLY_OVERLOAD_CASE(6)
+    FELLY_OVERLOAD_CASE(7)
+    FELLY_OVERLOAD_CASE(8)
+    FELLY_OVERLOAD_CASE(9)
+    FELLY_OVERLOAD_CASE(10)
+    FELLY_OVERLOAD_CASE(11)
+    FELLY_OVERLOAD_CASE(12)
+    FELLY_OVERLOAD_CASE(13)
+    FELLY_OVERLOAD_CASE(14)
+    FELLY_OVERLOAD_CASE(15)
+    default:
+      if constexpr (Offset + OverloadSwitchSize < N) {
+        return overload_switch<R, N, Offset + OverloadSwitchSize>(index, f);
+      } else {
+        if (FELLY_CHECK_FAILED(index != std::variant_npos)) [[unlikely]] {
+          raise_error<std::bad_variant_access>();
+        }
+        std::unreachable();
+      }
+  }
+#undef FELLY_OVERLOAD_CASE
+}
+
+// Dispatches on the first variant; the remaining variants are dispatched
+// within each case, so there is no table of all combinations
+template <class R, class F, class V, class... Rest>
+constexpr R overload_visit(F&& f, V&& v, Rest&&... rest) {
+  constexpr auto N = std::variant_size_v<std::remove_cvref_t<V>>;
+  auto visitor = [&]<std::size_t I>(std::integral_constant<std::size_t, I>)
+    -> R {
+    decltype(auto) alternative = overload_get<I>(std::forward<V>(v));
+    using A = decltype(alternative);
+    if constexpr (sizeof...(Rest) == 0) {
+      static_assert(
+        std::same_as<std::invoke_result_t<F, A>, R>,
+        "The visitor must return the same type for all alternatives");
+      return std::invoke(std::forward<F>(f), std::forward<A>(alternative));
+    } else {
+      return overload_visit<R>(
+        [&]<class... Others>(Others&&... others) -> R {
+          static_assert(
+            std::same_as<std::invoke_result_t<F, A, Others...>, R>,
+            "The visitor must return the same type for all alternatives");
+          return std::invoke(
+            std::forward<F>(f),
+            std::forward<A>(alternative),
+            std::forward<Others>(others)...);
+        },
+        std::forward<Rest>(rest)...);
+    }
+  };
+  return overload_switch<R, N>(v.index(), visitor);
+}
+
+}// namespace felly_detail
+
+namespace felly::inline overload_types {
+
+/** Like `std::visit()`, but dispatches with a `switch` on `index()`.
+ *
+ * This avoids the function pointer table that some standard libraries use
+ * for `std::visit()`, allowing the visitor to be inlined. As with
+ * `std::visit()`, the visitor must handle every alternative, and must return
+ * the same type for all of them.
+ *
+ * For multiple variants, each variant is dispatched within the `case` for the
+ * previous variant.
+ *
+ * If a variant is valueless by exception, this raises
+ * `std::bad_variant_access`.
+ */
+template <class F, felly_detail::overload_variant... Vs>
+  requires(sizeof...(Vs) > 0)
+constexpr decltype(auto) visit(F&& f, Vs&&... vs) {
+  using R
+    = std::invoke_result_t<F, felly_detail::overload_alternative_t<Vs>...>;
+  return felly_detail::overload_visit<R>(
+    std::forward<F>(f), std::forward<Vs>(vs)...);
+}
+
+/// Equivalent to `felly::visit(f, v)`, for a single variant
+template <felly_detail::overload_variant V, class F>
+constexpr decltype(auto) match(V&& v, F&& f) {
+  return felly::visit(std::forward<F>(f), std::forward<V>(v));
+}
+
+}// namespace felly::inline overload_types
@@ -0,0 +1,236 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "cold.hpp"
+#include "guarded_data.hpp"
+#include "hardware_interference_size.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace felly_detail {
+
+// One per `per_thread`, shared with the threads that use it so that they can
+// return their slot when they exit, even if the `per_thread` is being
+// destroyed
+template <class T>
+struct per_thread_state {
+  struct alignas(felly::hardware_destructive_interference_size) slot {
+    T mValue {};
+  };
+
+  struct slot_list {
+    std::vector<std::unique_ptr<slot>> mAll;
+    // Slots from exited threads; their values are kept, and reused by the
+    // next new thread
+    std::vector<slot*> mFree;
+  };
+
+  felly::guarded_data<slot_list> mSlots;
+
+  [[nodiscard]]
+  slot* acquire() {
+    auto slots = mSlots.lock();
+    if (!slots->mFree.empty()) {
+      const auto ret = slots->mFree.back();
+      slots->mFree.pop_back();
+      return ret;
+    }
+    auto& ret = slots->mAll.emplace_back(std::make_unique<slot>());
+    // So that `release()` can't fail
+    slots->mFree.reserve(slots->mAll.size());
+    return ret.get();
+  }
+
+  static void release(void* const self, void* const p) noexcept {
+    static_cast<per_thread_state*>(self)->mSlots.lock()->mFree.push_back(
+      static_cast<slot*>(p));
+  }
+};
+
+struct per_thread_recent_entry {
+  // `per_thread` IDs start at 1, and are never reused
+  std::uint64_t mID {0};
+  void* mSlot {nullptr};
+};
+
+// The slots used by the current thread, for all `per_thread`s
+struct per_thread_cache {
+  struct entry {
+    std::uint64_t mID {};
+    void* mSlot {nullptr};
+    std::weak_ptr<void> mOwner;
+    void (*mRelease)(void* owner, void* slot) noexcept {nullptr};
+  };
+
+  using recent_entry = per_thread_recent_entry;
+
+  // Recently used slots, indexed by ID, so that using a few `per_thread`s in
+  // turn does not miss. These are trivially destructible, so unlike the
+  // cache, they are still valid while other thread_locals are being
+  // destroyed.
+  static constexpr std::size_t RecentCount = 8;
+  static constinit inline thread_local std::array<recent_entry, RecentCount>
+    tRecent {};
+  // Set when the thread is exiting, after its slots have been released
+  static constinit inline thread_local bool tDestroyed {false};
+
+  std::vector<entry> mEntries;
+
+  per_thread_cache() = default;
+  per_thread_cache(const per_thread_cache&) = delete;
+  per_thread_cache& operator=(const per_thread_cache&) = delete;
+
+  ~per_thread_cache() {
+    // Before releasing, so that this thread can not use a slot that has been
+    // handed to another thread
+    tRecent = {};
+    tDestroyed = true;
+    for (auto&& it: mEntries) {
+      if (const auto owner = it.mOwner.lock()) {
+        it.mRelease(owner.get(), it.mSlot);
+      }
+    }
+  }
+
+  [[nodiscard]]
+  static recent_entry& recent(const std::uint64_t id) noexcept {
+    return tRecent[id % RecentCount];
+  }
+
+  // Returns nullptr if the thread's cache has been destroyed
+  [[nodiscard]]
+  static per_thread_cache* get() noexcept {
+    if (tDestroyed) [[unlikely]] {
+      return nullptr;
+    }
+    thread_local per_thread_cache instance;
+    return &instance;
+  }
+
+  // Returns nullptr if this thread does not have a slot for `id`
+  [[nodiscard]]
+  void* find(const std::uint64_t id) noexcept {
+    const auto it = std::ranges::find(mEntries, id, &entry::mID);
+    if (it == mEntries.end()) {
+      return nullptr;
+    }
+    recent(id) = {id, it->mSlot};
+    return it->mSlot;
+  }
+
+  // Call before `insert()`, so that a slot is not acquired and then lost
+  void reserve_one() {
+    // Remove entries for destroyed `per_thread`s
+    std::erase_if(
+      mEntries, [](const entry& it) { return it.mOwner.expired(); });
+    mEntries.reserve(mEntries.size() + 1);
+  }
+
+  void insert(entry e) noexcept {
+    recent(e.mID) = {e.mID, e.mSlot};
+    mEntries.push_back(std::move(e));
+  }
+};
+
+inline std::atomic<std::uint64_t> per_thread_next_id {1};
+
+}// namespace felly_detail
+
+namespace felly::inline per_thread_types {
+
+/** A separate `T` for each thread, such as a counter or histogram.
+ *
+ * `local()` returns the calling thread's `T` without locking; each `T` is on
+ * its own cache line, so threads do not contend with each other. `reduce()`
+ * combines the values from all threads.
+ *
+ * A `guarded_data` is only locked when a thread uses a `per_thread` for the
+ * first time, when the thread exits, and by `reduce()`. When a thread exits,
+ * its `T` is kept, and is reused by the next new thread, so `reduce()` still
+ * includes values from exited threads.
+ *
+ * `local()` may be called from a `thread_local` destructor; if the thread has
+ * already released its slots, it gets a `T` that is not reused by other
+ * threads, but is still included by `reduce()`.
+ *
+ * `reduce()` reads the other threads' values while they may still be
+ * changing them; unless they have all finished, `T` should be made of
+ * atomics, e.g. `std::atomic<std::uint64_t>` with relaxed increments.
+ */
+template <class T>
+  requires std::default_initializable<T>
+class per_thread {
+ public:
+  per_thread() = default;
+  per_thread(const per_thread&) = delete;
+  per_thread& operator=(const per_thread&) = delete;
+
+  [[nodiscard]]
+  T& local() {
+    const auto& recent = felly_detail::per_thread_cache::recent(mID);
+    if (recent.mID == mID) [[likely]] {
+      return static_cast<slot*>(recent.mSlot)->mValue;
+    }
+    return local_slow();
+  }
+
+  /// Returns `f(...f(f(init, first), second)..., last)` for all threads' values
+  template <class R, class F>
+    requires std::invocable<F&, R, const T&>
+    && std::convertible_to<std::invoke_result_t<F&, R, const T&>, R>
+  [[nodiscard]]
+  R reduce(R init, F&& f) const {
+    const auto slots = mState->mSlots.lock();
+    for (auto&& it: slots->mAll) {
+      init = std::invoke(f, std::move(init), std::as_const(it->mValue));
+    }
+    return init;
+  }
+
+ private:
+  using state = felly_detail::per_thread_state<T>;
+  using slot = state::slot;
+
+  const std::uint64_t mID {felly_detail::per_thread_next_id.fetch_add(
+    1, std::memory_order_relaxed)};
+  const std::shared_ptr<state> mState {std::make_shared<state>()};
+
+  FELLY_NOINLINE T& local_slow() {
+    using cache_type = felly_detail::per_thread_cache;
+    const auto cache = cache_type::get();
+    if (!cache) [[unlikely]] {
+      // Called from a thread_local destructor after this thread's slots were
+      // released. This slot is never released, but it is still included by
+      // `reduce()`, and is remembered so that later calls do not acquire more
+      const auto p = mState->acquire();
+      cache_type::recent(mID) = {mID, p};
+      return p->mValue;
+    }
+
+    if (const auto p = cache->find(mID)) {
+      return static_cast<slot*>(p)->mValue;
+    }
+    cache->reserve_one();
+    const auto p = mState->acquire();
+    cache->insert({
+      .mID = mID,
+      .mSlot = p,
+      .mOwner = mState,
+      .mRelease = &state::release,
+    });
+    return p->mValue;
+  }
+};
+
+}// namespace felly::inline per_thread_types
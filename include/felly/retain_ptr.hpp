@@ -0,0 +1,240 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "error_policy.hpp"
+#include "unique_any.hpp"
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace felly::inline retain_ptr_types {
+
+/// Take ownership of an existing reference
+struct adopt_ref_t {
+  explicit adopt_ref_t() = default;
+};
+inline constexpr adopt_ref_t adopt_ref {};
+
+/// Add a new reference
+struct retain_ref_t {
+  explicit retain_ref_t() = default;
+};
+inline constexpr retain_ref_t retain_ref {};
+
+/** A shared pointer to an object with an intrusive reference count.
+ *
+ * For example, COM objects, or C libraries with `foo_ref()`/`foo_unref()`.
+ * This is the size of a pointer; unlike `std::shared_ptr`, there is no
+ * separate control block.
+ *
+ * `TAddRef` and `TRelease` are invoked like `unique_any` deleters, so they
+ * may take a `T*` for a `const T`. Pointers are only stored if they are
+ * non-null, and satisfy `TPredicate` if provided.
+ *
+ * Construction and `reset()` take `adopt_ref` or `retain_ref` to make the
+ * ownership explicit; `std::out_ptr(p, felly::adopt_ref)` and
+ * `std::inout_ptr(p, felly::adopt_ref)` also work.
+ */
+template <class T, auto TAddRef, auto TRelease, auto TPredicate = nullptr>
+  requires felly_detail::invocable_as_deleter<TAddRef, T*>
+  && felly_detail::invocable_as_deleter<TRelease, T*>
+  && felly_detail::nullptr_or_predicate<decltype(TPredicate), T*>
+class retain_ptr {
+ public:
+  using pointer = T*;
+  using element_type = T;
+
+  constexpr retain_ptr() noexcept = default;
+  constexpr retain_ptr(std::nullptr_t) noexcept {}
+
+  constexpr retain_ptr(const pointer p, adopt_ref_t) noexcept
+    : mPtr(has_value(p) ? p : nullptr) {}
+
+  constexpr retain_ptr(const pointer p, retain_ref_t)
+    : mPtr(has_value(p) ? p : nullptr) {
+    add_ref();
+  }
+
+  /** Adopt the reference owned by a `unique_any`, without adding a new one.
+   *
+   * The `unique_any`'s deleter is not checked, so it must be equivalent to
+   * `TRelease`; the tag is required to make this explicit.
+   */
+  template <class UTraits>
+    requires std::same_as<
+      std::remove_const_t<typename UTraits::value_type>,
+      pointer>
+  constexpr explicit retain_ptr(basic_unique_any<UTraits>&& other, adopt_ref_t)
+    : retain_ptr(other ? pointer {other.disown()} : nullptr, adopt_ref) {}
+
+  constexpr retain_ptr(const retain_ptr& other) : mPtr(other.mPtr) {
+    add_ref();
+  }
+
+  constexpr retain_ptr(retain_ptr&& other) noexcept
+    : mPtr(std::exchange(other.mPtr, nullptr)) {}
+
+  constexpr retain_ptr& operator=(const retain_ptr& other) {
+    // Add first, in case this is the last reference to the same object
+    retain_ptr copy {other};
+    swap(copy);
+    return *this;
+  }
+
+  constexpr retain_ptr& operator=(retain_ptr&& other) noexcept {
+    retain_ptr moved {std::move(other)};
+    swap(moved);
+    return *this;
+  }
+
+  constexpr ~retain_ptr() {
+    release();
+  }
+
+  constexpr void reset() noexcept {
+    release();
+    mPtr = nullptr;
+  }
+
+  constexpr void reset(const pointer p, adopt_ref_t) noexcept {
+    retain_ptr replacement {p, adopt_ref};
+    swap(replacement);
+  }
+
+  constexpr void reset(const pointer p, retain_ref_t) {
+    retain_ptr replacement {p, retain_ref};
+    swap(replacement);
+  }
+
+  /// Release ownership of the reference without decrementing it
+  [[nodiscard]]
+  constexpr pointer disown() noexcept {
+    return std::exchange(mPtr, nullptr);
+  }
+
+  constexpr void swap(retain_ptr& other) noexcept {
+    std::swap(mPtr, other.mPtr);
+  }
+
+  /// May be `nullptr`
+  [[nodiscard]]
+  constexpr pointer get() const noexcept {
+    return mPtr;
+  }
+
+  [[nodiscard]]
+  constexpr T& operator*() const {
+    require_value();
+    return *mPtr;
+  }
+
+  constexpr pointer operator->() const {
+    require_value();
+    return mPtr;
+  }
+
+  constexpr explicit operator bool() const noexcept {
+    return mPtr != nullptr;
+  }
+
+  [[nodiscard]]
+  friend constexpr auto operator<=>(const retain_ptr&, const retain_ptr&)
+    = default;
+
+  [[nodiscard]]
+  constexpr bool operator==(const retain_ptr&) const noexcept = default;
+
+  [[nodiscard]]
+  constexpr bool operator==(std::nullptr_t) const noexcept {
+    return mPtr == nullptr;
+  }
+
+ private:
+  pointer mPtr {nullptr};
+
+  static constexpr bool has_value(const pointer p) noexcept {
+    if constexpr (std::same_as<decltype(TPredicate), std::nullptr_t>) {
+      return p != nullptr;
+    } else {
+      return p != nullptr && std::invoke(TPredicate, p);
+    }
+  }
+
+  constexpr void add_ref() {
+    if (mPtr) {
+      felly_detail::invoke_as_deleter<TAddRef>(mPtr);
+    }
+  }
+
+  constexpr void release() noexcept {
+    if (mPtr) {
+      felly_detail::invoke_as_deleter<TRelease>(mPtr);
+    }
+  }
+
+  constexpr void require_value() const {
+    if (FELLY_CHECK_FAILED(mPtr != nullptr)) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Can't dereference an empty retain_ptr");
+    }
+  }
+};
+
+}// namespace felly::inline retain_ptr_types
+
+namespace std {
+/* Support `std::inout_ptr`
+ *
+ * This specialization is needed because we use `disown()` instead of
+ * `release()`; as with construction, `felly::adopt_ref` or `felly::retain_ref`
+ * must be passed to `std::inout_ptr()`.
+ */
+template <
+  class T,
+  auto TAddRef,
+  auto TRelease,
+  auto TPredicate,
+  class Pointer,
+  class... Args>
+class inout_ptr_t<
+  felly::retain_ptr<T, TAddRef, TRelease, TPredicate>,
+  Pointer,
+  Args...> {
+  using Smart = felly::retain_ptr<T, TAddRef, TRelease, TPredicate>;
+  Smart& smart;
+  Pointer ptr {};
+  std::tuple<Args...> args;
+
+ public:
+  explicit constexpr inout_ptr_t(Smart& smart, Args&&... args) noexcept
+    : smart(smart),
+      args(std::forward<Args>(args)...) {
+    ptr = smart.disown();
+  }
+  inout_ptr_t(const inout_ptr_t&) = delete;
+
+  constexpr ~inout_ptr_t() {
+    std::apply(
+      [this]<typename... Ts>(Ts&&... resetArgs) {
+        smart.reset(ptr, std::forward<Ts>(resetArgs)...);
+      },
+      std::move(args));
+  }
+
+  constexpr operator Pointer*() noexcept { return std::addressof(ptr); }
+
+  constexpr operator void**() noexcept
+    requires(!std::same_as<Pointer, void*>)
+  {
+    return reinterpret_cast<void**>(std::addressof(ptr));
+  }
+};
+}// namespace std
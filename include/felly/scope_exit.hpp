@@ -4,9 +4,12 @@
 
 #include "no_unique_address.hpp"
 
+#include <array>
 #include <concepts>
+#include <cstddef>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -71,6 +74,140 @@ class [[nodiscard]] basic_scope_exit {
 
   void release() noexcept { mOwned = false; }
 };
+
+/* A LIFO stack of callbacks that are executed when the scope exits.
+ *
+ * Up to `TCapacity` callbacks are stored inline; heap blocks of `TCapacity`
+ * more callbacks are allocated as needed. Callbacks must fit in
+ * `TCallbackSize` bytes, so no callback needs its own allocation.
+ */
+template <
+  basic_scope_exit_execution_policy TWhen,
+  std::size_t TCapacity,
+  std::size_t TCallbackSize>
+  requires(TCapacity > 0)
+class [[nodiscard]] basic_scope_exit_stack {
+  using enum basic_scope_exit_execution_policy;
+
+  struct slot {
+    alignas(std::max_align_t) std::byte mStorage[TCallbackSize];
+    // Invokes the callback if requested, then destroys it
+    void (*mRun)(std::byte*, bool) noexcept;
+  };
+
+  struct overflow_block {
+    std::array<slot, TCapacity> mSlots;
+    std::unique_ptr<overflow_block> mPrevious;
+  };
+
+  FELLY_NO_UNIQUE_ADDRESS
+  std::conditional_t<TWhen != Always, int, detail::empty> mInitialUncaught {};
+
+  std::array<slot, TCapacity> mInline;
+  // The most recently allocated block; there is only a block if all earlier
+  // storage is full
+  std::unique_ptr<overflow_block> mOverflow;
+  // Number of callbacks in the most recent block
+  std::size_t mSize {0};
+
+  template <class F>
+  static void run(std::byte* const storage, const bool invoke) noexcept {
+    const auto f = std::launder(reinterpret_cast<F*>(storage));
+    if (invoke) {
+      std::invoke(*f);
+    }
+    std::destroy_at(f);
+  }
+
+  std::array<slot, TCapacity>& current_slots() noexcept {
+    return mOverflow ? mOverflow->mSlots : mInline;
+  }
+
+  void run_all(const bool invoke) noexcept {
+    while (true) {
+      auto& slots = current_slots();
+      while (mSize > 0) {
+        --mSize;
+        slots[mSize].mRun(slots[mSize].mStorage, invoke);
+      }
+      if (!mOverflow) {
+        return;
+      }
+      mOverflow = std::move(mOverflow->mPrevious);
+      mSize = TCapacity;
+    }
+  }
+
+ public:
+  static constexpr std::size_t inline_capacity = TCapacity;
+  static constexpr std::size_t max_callback_size = TCallbackSize;
+
+  basic_scope_exit_stack() {
+    if constexpr (TWhen != Always) {
+      mInitialUncaught = std::uncaught_exceptions();
+    }
+  }
+
+  ~basic_scope_exit_stack() noexcept {
+    if constexpr (TWhen == Always) {
+      run_all(true);
+    } else if constexpr (TWhen == OnFailure) {
+      run_all(std::uncaught_exceptions() > mInitialUncaught);
+    } else if constexpr (TWhen == OnSuccess) {
+      run_all(std::uncaught_exceptions() == mInitialUncaught);
+    }
+  }
+
+  basic_scope_exit_stack(const basic_scope_exit_stack&) = delete;
+  basic_scope_exit_stack& operator=(const basic_scope_exit_stack&) = delete;
+
+  /** Add a callback, which will be executed before any earlier callbacks.
+   *
+   * If this throws - e.g. if a heap block can not be allocated, or `f` can
+   * not be moved - the callback is not added.
+   */
+  template <class F>
+    requires std::invocable<std::remove_cvref_t<F>&>
+    && std::constructible_from<std::remove_cvref_t<F>, F&&>
+    && (sizeof(std::remove_cvref_t<F>) <= TCallbackSize)
+    && (alignof(std::remove_cvref_t<F>) <= alignof(std::max_align_t))
+  void push(F&& f) {
+    using callback_type = std::remove_cvref_t<F>;
+    if (mSize == TCapacity) {
+      auto block = std::make_unique_for_overwrite<overflow_block>();
+      block->mPrevious = std::move(mOverflow);
+      mOverflow = std::move(block);
+      mSize = 0;
+    }
+    auto& entry = current_slots()[mSize];
+    std::construct_at(
+      reinterpret_cast<callback_type*>(entry.mStorage), std::forward<F>(f));
+    entry.mRun = &run<callback_type>;
+    ++mSize;
+  }
+
+  /// Destroy all callbacks without executing them
+  void release() noexcept {
+    run_all(false);
+  }
+
+  [[nodiscard]]
+  std::size_t size() const noexcept {
+    if (!mOverflow) {
+      return mSize;
+    }
+    std::size_t size = TCapacity + mSize;
+    for (auto it = mOverflow->mPrevious.get(); it; it = it->mPrevious.get()) {
+      size += TCapacity;
+    }
+    return size;
+  }
+
+  [[nodiscard]]
+  bool empty() const noexcept {
+    return mSize == 0 && !mOverflow;
+  }
+};
 }// namespace felly::detail
 
 namespace felly::inline scope_exit_types {
@@ -94,4 +231,22 @@ struct scope_success : detail::basic_scope_exit<
                          T> {};
 template <class T>
 scope_success(T) -> scope_success<T>;
+
+template <std::size_t N, std::size_t TCallbackSize = 4 * sizeof(void*)>
+using scope_exit_stack = detail::basic_scope_exit_stack<
+  detail::basic_scope_exit_execution_policy::Always,
+  N,
+  TCallbackSize>;
+
+template <std::size_t N, std::size_t TCallbackSize = 4 * sizeof(void*)>
+using scope_fail_stack = detail::basic_scope_exit_stack<
+  detail::basic_scope_exit_execution_policy::OnFailure,
+  N,
+  TCallbackSize>;
+
+template <std::size_t N, std::size_t TCallbackSize = 4 * sizeof(void*)>
+using scope_success_stack = detail::basic_scope_exit_stack<
+  detail::basic_scope_exit_execution_policy::OnSuccess,
+  N,
+  TCallbackSize>;
 }// namespace felly::inline scope_exit_types
@@ -0,0 +1,210 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "adaptive_mutex.hpp"
+#include "error_policy.hpp"
+#include "hardware_interference_size.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace felly::inline seqlocked_types {
+
+template <class T, class TMutex>
+class seqlocked;
+
+/** Write access to a `seqlocked<T>`.
+ *
+ * This holds a copy of the value; modifications are published to readers when
+ * the lock is unlocked or destroyed.
+ */
+template <class T, class TMutex = std::mutex>
+class seqlocked_write_lock {
+ public:
+  seqlocked_write_lock() = delete;
+  seqlocked_write_lock(const seqlocked_write_lock&) = delete;
+  seqlocked_write_lock& operator=(const seqlocked_write_lock&) = delete;
+
+  seqlocked_write_lock(seqlocked_write_lock&& other) noexcept
+    : mLock(std::move(other.mLock)),
+      mOwner(std::exchange(other.mOwner, nullptr)),
+      mValue(other.mValue) {}
+
+  seqlocked_write_lock& operator=(seqlocked_write_lock&& other) noexcept {
+    if (std::addressof(other) == this) {
+      return *this;
+    }
+    if (mOwner) {
+      unlock();
+    }
+    mLock = std::move(other.mLock);
+    mOwner = std::exchange(other.mOwner, nullptr);
+    mValue = other.mValue;
+    return *this;
+  }
+
+  ~seqlocked_write_lock() {
+    if (mOwner) {
+      unlock();
+    }
+  }
+
+  operator bool() const noexcept { return mOwner != nullptr; }
+
+  T const* operator->() const noexcept { return &mValue; }
+
+  T* operator->() noexcept { return &mValue; }
+
+  [[nodiscard]]
+  const T& get() const noexcept {
+    return mValue;
+  }
+
+  [[nodiscard]]
+  T& get() noexcept {
+    return mValue;
+  }
+
+  [[nodiscard]]
+  const T& operator*() const noexcept {
+    return mValue;
+  }
+
+  [[nodiscard]]
+  T& operator*() noexcept {
+    return mValue;
+  }
+
+  /// Publish the modified value, and release the lock
+  void unlock() {
+    if (FELLY_CHECK_FAILED(mOwner && mLock.owns_lock())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Unlocking a lock that isn't locked");
+    }
+    std::exchange(mOwner, nullptr)->publish(mValue);
+    mLock.unlock();
+  }
+
+ private:
+  friend class seqlocked<T, TMutex>;
+
+  seqlocked_write_lock(
+    std::unique_lock<TMutex> lock,
+    seqlocked<T, TMutex>* owner,
+    const T& value)
+    : mLock(std::move(lock)),
+      mOwner(owner),
+      mValue(value) {}
+
+  std::unique_lock<TMutex> mLock;
+  seqlocked<T, TMutex>* mOwner {nullptr};
+  T mValue;
+};
+
+/** A value that can be read without locking, for read-mostly data.
+ *
+ * Readers take an optimistic copy, and retry if a write was in progress;
+ * readers never block writers, and do not write to shared memory, so the cost
+ * of reading does not increase with the number of readers.
+ *
+ * Reads are lock-free, but not wait-free: a reader spins while a write is in
+ * progress, and retries if one started during its copy, so a continuous
+ * stream of writes can delay readers indefinitely.
+ *
+ * Writers are serialized with `TMutex`.
+ *
+ * This is only suitable for small trivially-copyable values, as every read and
+ * write copies the entire value.
+ */
+template <class T, class TMutex = std::mutex>
+class seqlocked {
+  static_assert(std::is_trivially_copyable_v<T>);
+  static_assert(!std::is_const_v<T>);
+
+ public:
+  template <class... Args>
+  explicit seqlocked(Args&&... args) {
+    publish(T {std::forward<Args>(args)...});
+  }
+
+  seqlocked(const seqlocked&) = delete;
+  seqlocked& operator=(const seqlocked&) = delete;
+
+  [[nodiscard]]
+  T load() const noexcept {
+    while (true) {
+      const auto before = mSequence.load(std::memory_order_acquire);
+      if ((before & 1) != 0) [[unlikely]] {
+        // Write in progress
+        felly_detail::cpu_relax();
+        continue;
+      }
+
+      word_array words;
+      for (std::size_t i = 0; i < WordCount; ++i) {
+        words[i] = mWords[i].load(std::memory_order_relaxed);
+      }
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (mSequence.load(std::memory_order_relaxed) == before) [[likely]] {
+        // `T` is not required to be default-constructible
+        std::array<std::byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), words.data(), sizeof(T));
+        return std::bit_cast<T>(bytes);
+      }
+    }
+  }
+
+  void store(const T& value) {
+    const std::unique_lock lock {mWriterMutex};
+    publish(value);
+  }
+
+  [[nodiscard]]
+  seqlocked_write_lock<T, TMutex> lock() {
+    std::unique_lock lock {mWriterMutex};
+    // We hold the writer lock, so this can't be modified while we read it
+    return {std::move(lock), this, load()};
+  }
+
+ private:
+  friend class seqlocked_write_lock<T, TMutex>;
+
+  // Copied via relaxed atomics to avoid data races between readers and the
+  // writer; these are plain loads and stores on major platforms
+  using word_type = std::size_t;
+  static_assert(std::atomic<word_type>::is_always_lock_free);
+  static constexpr auto WordCount
+    = (sizeof(T) + sizeof(word_type) - 1) / sizeof(word_type);
+  using word_array = std::array<word_type, WordCount>;
+
+  alignas(hardware_destructive_interference_size)
+    std::atomic<std::size_t> mSequence {0};
+  std::array<std::atomic<word_type>, WordCount> mWords {};
+  // On its own cache line, so that writers contending for the mutex do not
+  // invalidate the line that readers are reading
+  alignas(hardware_destructive_interference_size) TMutex mWriterMutex;
+
+  void publish(const T& value) noexcept {
+    word_array words {};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    const auto sequence = mSequence.load(std::memory_order_relaxed);
+    mSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < WordCount; ++i) {
+      mWords[i].store(words[i], std::memory_order_relaxed);
+    }
+    mSequence.store(sequence + 2, std::memory_order_release);
+  }
+};
+
+}// namespace felly::inline seqlocked_types
@@ -0,0 +1,113 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "guarded_data.hpp"
+#include "no_unique_address.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace felly_detail {
+
+struct sharded_guarded_data_default_hash {
+  template <class K>
+  [[nodiscard]]
+  std::size_t operator()(const K& key) const noexcept(
+    noexcept(std::hash<K> {}(key))) {
+    return std::hash<K> {}(key);
+  }
+};
+
+}// namespace felly_detail
+
+namespace felly::inline sharded_guarded_data_types {
+
+/** `N` independently-locked `T`s, selected by hashing a key.
+ *
+ * This reduces contention when keys are spread across shards; each shard is an
+ * `aligned_guarded_data`, so shards do not share cache lines.
+ *
+ * Operations that need to see every shard can use `for_each_shard()`; this
+ * locks each shard in turn, not all at once.
+ */
+template <
+  class T,
+  std::size_t N,
+  class THash = felly_detail::sharded_guarded_data_default_hash,
+  class TMutex = std::mutex>
+  requires(N > 0)
+class sharded_guarded_data {
+ public:
+  using shard_type = aligned_guarded_data<T, TMutex>;
+  static constexpr std::size_t shard_count = N;
+
+  /// Each shard is constructed with a copy of the arguments
+  template <class... Args>
+  explicit sharded_guarded_data(const Args&... args)
+    : sharded_guarded_data(std::make_index_sequence<N> {}, args...) {}
+
+  template <class K>
+  [[nodiscard]]
+  std::size_t shard_index(const K& key) const
+    noexcept(std::is_nothrow_invocable_v<const THash&, const K&>) {
+    return std::invoke(mHash, key) % N;
+  }
+
+  [[nodiscard]]
+  shard_type& shard(const std::size_t index) noexcept {
+    return mShards[index];
+  }
+
+  [[nodiscard]]
+  const shard_type& shard(const std::size_t index) const noexcept {
+    return mShards[index];
+  }
+
+  template <class K>
+  [[nodiscard]]
+  auto lock(const K& key) {
+    return shard(shard_index(key)).lock();
+  }
+
+  template <class K>
+  [[nodiscard]]
+  auto lock(const K& key) const {
+    return shard(shard_index(key)).lock();
+  }
+
+  /** Invoke `f(T&)` for each shard, while holding the lock for that shard.
+   *
+   * Unconstrained so that generic lambdas don't need to be valid for both
+   * `T&` and `const T&`.
+   */
+  template <class F>
+  void for_each_shard(F&& f) {
+    for (auto&& shard: mShards) {
+      auto lock = shard.lock();
+      std::invoke(f, lock.get());
+    }
+  }
+
+  template <class F>
+  void for_each_shard(F&& f) const {
+    for (auto&& shard: mShards) {
+      auto lock = shard.lock();
+      std::invoke(f, lock.get());
+    }
+  }
+
+ private:
+  FELLY_NO_UNIQUE_ADDRESS THash mHash {};
+  std::array<shard_type, N> mShards;
+
+  // Shards aren't movable, so each must be initialized from a prvalue
+  template <std::size_t... I, class... Args>
+  explicit sharded_guarded_data(std::index_sequence<I...>, const Args&... args)
+    : mShards {(static_cast<void>(I), shard_type(args...))...} {}
+};
+
+}// namespace felly::inline sharded_guarded_data_types
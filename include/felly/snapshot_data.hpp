@@ -0,0 +1,145 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace felly::inline snapshot_data_types {
+
+/** An immutable version of the data in a `snapshot_data<T>`.
+ *
+ * Snapshots are cheap to copy; the version is freed when the last snapshot of
+ * it is destroyed.
+ */
+template <class T>
+class snapshot {
+ public:
+  snapshot() = delete;
+  explicit snapshot(std::shared_ptr<const T> data) noexcept
+    : mData(std::move(data)) {}
+
+  T const* operator->() const noexcept { return mData.get(); }
+
+  [[nodiscard]]
+  const T& get() const noexcept {
+    return *mData;
+  }
+
+  [[nodiscard]]
+  const T& operator*() const noexcept {
+    return *mData;
+  }
+
+  /// Whether or not this is a snapshot of the same version as another
+  [[nodiscard]]
+  bool operator==(const snapshot& other) const noexcept {
+    return mData == other.mData;
+  }
+
+ private:
+  std::shared_ptr<const T> mData;
+};
+
+/** Copy-on-write data, for large read-mostly values.
+ *
+ * `read()` returns a `snapshot` of the current version; `update()` copies the
+ * current version, modifies the copy, and then publishes it for future
+ * readers. Existing snapshots continue to see the version they were created
+ * from.
+ *
+ * Writers are serialized with `TMutex`, which readers never take, so readers
+ * do not wait for `update()` to copy or modify the value. However, loading
+ * and publishing the current version is not lock-free on major standard
+ * libraries: `std::atomic<std::shared_ptr>` (libstdc++, MSVC) uses a short
+ * internal lock, and the fallback `std::atomic_load()` functions (libc++)
+ * use a global pool of mutexes, which may be shared with unrelated
+ * `std::shared_ptr`s.
+ */
+template <class T, class TMutex = std::mutex>
+class snapshot_data {
+  static_assert(!std::is_const_v<T>);
+  static_assert(std::copy_constructible<T>);
+
+ public:
+  template <class... Args>
+  explicit snapshot_data(Args&&... args)
+    : mCurrent(std::make_shared<const T>(std::forward<Args>(args)...)) {}
+
+  snapshot_data(const snapshot_data&) = delete;
+  snapshot_data& operator=(const snapshot_data&) = delete;
+
+  [[nodiscard]]
+  snapshot<T> read() const noexcept {
+    return snapshot<T> {current()};
+  }
+
+  /** Invoke `f(T&)` on a copy of the current version, then publish it.
+   *
+   * Returns a copy of the result of `f()`. If `f()` throws, nothing is
+   * published.
+   */
+  template <std::invocable<T&> F>
+  decltype(auto) update(F&& f) {
+    const std::unique_lock lock {mWriterMutex};
+    auto next = std::make_shared<T>(*current());
+    if constexpr (std::is_void_v<std::invoke_result_t<F, T&>>) {
+      std::invoke(std::forward<F>(f), *next);
+      publish(std::move(next));
+    } else {
+      auto ret = std::invoke(std::forward<F>(f), *next);
+      publish(std::move(next));
+      return ret;
+    }
+  }
+
+  /// Replace the current version without copying it
+  void store(T value) {
+    const std::unique_lock lock {mWriterMutex};
+    publish(std::make_shared<const T>(std::move(value)));
+  }
+
+ private:
+  TMutex mWriterMutex;
+
+#if __cpp_lib_atomic_shared_ptr >= 201711L
+  // Usually not lock-free; see the class comment
+  std::atomic<std::shared_ptr<const T>> mCurrent;
+
+  std::shared_ptr<const T> current() const noexcept {
+    return mCurrent.load(std::memory_order_acquire);
+  }
+
+  void publish(std::shared_ptr<const T> next) noexcept {
+    mCurrent.store(std::move(next), std::memory_order_release);
+  }
+#else
+  // Some standard libraries (e.g. libc++) do not implement
+  // `std::atomic<std::shared_ptr>`; use the older (deprecated in C++20) free
+  // functions instead
+  std::shared_ptr<const T> mCurrent;
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+  std::shared_ptr<const T> current() const noexcept {
+    return std::atomic_load_explicit(&mCurrent, std::memory_order_acquire);
+  }
+
+  void publish(std::shared_ptr<const T> next) noexcept {
+    std::atomic_store_explicit(
+      &mCurrent, std::move(next), std::memory_order_release);
+  }
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+#endif
+};
+
+}// namespace felly::inline snapshot_data_types
@@ -0,0 +1,104 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+// P2786: lets the compiler treat a class as trivially relocatable if all of
+// its bases and members are, even with a user-provided move constructor and
+// destructor
+#if defined(__cpp_trivial_relocatability)
+#define FELLY_TRIVIALLY_RELOCATABLE_IF_ELIGIBLE \
+  trivially_relocatable_if_eligible
+#else
+#define FELLY_TRIVIALLY_RELOCATABLE_IF_ELIGIBLE
+#endif
+
+namespace felly_detail {
+
+template <class T>
+constexpr bool builtin_is_trivially_relocatable() {
+#if defined(__cpp_lib_trivially_relocatable)
+  return std::is_trivially_relocatable_v<T>;
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_cpp_trivially_relocatable)
+  return __builtin_is_cpp_trivially_relocatable(T);
+#elif __has_builtin(__is_trivially_relocatable)
+  return __is_trivially_relocatable(T);
+#else
+  return false;
+#endif
+#else
+  return false;
+#endif
+}
+
+}// namespace felly_detail
+
+namespace felly::inline trivially_relocatable_types {
+
+/** Whether a `T` can be moved to a new address with `memcpy()`, without
+ * running the move constructor or the destructor of the original.
+ *
+ * This uses P2786 or compiler builtins where available, and is otherwise true
+ * for trivially copyable types. Specialize this to opt in other types, e.g.
+ * those that own a pointer but never point into themselves:
+ *
+ * ```
+ * template <>
+ * struct felly::is_trivially_relocatable<my_handle> : std::true_type {};
+ * ```
+ */
+template <class T>
+struct is_trivially_relocatable
+  : std::bool_constant<
+      std::is_trivially_copyable_v<T>
+      || felly_detail::builtin_is_trivially_relocatable<T>()> {};
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v
+  = is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+template <class T>
+struct is_trivially_relocatable<std::optional<T>>
+  : is_trivially_relocatable<std::remove_cv_t<T>> {};
+
+/** Move-constructs `[first, last)` into uninitialized storage at `result`,
+ * and destroys the originals; returns the end of the new range.
+ *
+ * If `T` is trivially relocatable, this is a single `memmove()`. The ranges
+ * may overlap if `result` is before `first`, e.g. when erasing.
+ */
+template <class T>
+  requires is_trivially_relocatable_v<T>
+  || std::is_nothrow_move_constructible_v<T>
+T* relocate(T* const first, T* const last, T* const result) noexcept {
+  const auto count = static_cast<std::size_t>(last - first);
+  if constexpr (is_trivially_relocatable_v<T>) {
+#if defined(__cpp_lib_trivially_relocatable)
+    // Also ends the lifetime of the originals, and starts the new ones
+    if constexpr (std::is_trivially_relocatable_v<T>) {
+      return std::trivially_relocate(first, last, result);
+    }
+#endif
+    if (count > 0) {
+      std::memmove(
+        static_cast<void*>(result),
+        static_cast<const void*>(first),
+        count * sizeof(T));
+    }
+    return result + count;
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      std::construct_at(result + i, std::move(first[i]));
+      std::destroy_at(first + i);
+    }
+    return result + count;
+  }
+}
+
+}// namespace felly::inline trivially_relocatable_types
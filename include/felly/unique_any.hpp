@@ -2,6 +2,9 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 
+#include "error_policy.hpp"
+#include "trivially_relocatable.hpp"
+
 #include <compare>
 #include <concepts>
 #include <functional>
@@ -181,6 +184,58 @@ struct unique_any_pointer_traits {
   }
 };
 
+/** Traits for types with an in-band invalid value, such as `-1` for FDs.
+ *
+ * The sentinel is the empty state, so the storage is just a `T`, instead of
+ * an `std::optional<T>`. If `TPredicate` is provided, values are also empty
+ * if they do not satisfy it.
+ */
+template <
+  class T,
+  auto TDeleter,
+  auto TSentinel,
+  felly_detail::nullptr_or_predicate<const T&> auto TPredicate = nullptr>
+  requires(!std::is_pointer_v<T>)
+  && std::equality_comparable<T>
+  && std::convertible_to<decltype(TSentinel), std::remove_const_t<T>>
+  && felly_detail::invocable_as_deleter<TDeleter, std::remove_const_t<T>&>
+struct unique_any_sentinel_traits {
+  using value_type = T;
+  using storage_type = std::remove_const_t<T>;
+
+  static constexpr bool has_predicate
+    = !std::same_as<decltype(TPredicate), std::nullptr_t>;
+
+  static constexpr storage_type default_value() noexcept {
+    return TSentinel;
+  }
+
+  static constexpr void destroy(storage_type& s) {
+    auto temp = std::exchange(s, default_value());
+    felly_detail::invoke_as_deleter_t<TDeleter> {}(temp);
+  }
+
+  [[nodiscard]] static constexpr bool has_value(
+    const storage_type& s) noexcept {
+    if constexpr (has_predicate) {
+      return s != default_value() && std::invoke(TPredicate, s);
+    } else {
+      return s != default_value();
+    }
+  }
+
+  template <class U>
+  [[nodiscard]] static constexpr decltype(auto) value(U&& s) {
+    return felly_detail::unique_any_forward_like<U>(s);
+  }
+
+  constexpr static void construct(
+    storage_type& s,
+    std::add_const_t<value_type> v) {
+    s = v;
+  }
+};
+
 template <class T>
 inline constexpr auto unique_any_default_delete = std::is_pointer_v<T>
   ? std::default_delete<std::remove_const_t<std::remove_pointer_t<T>>> {}
@@ -232,9 +287,12 @@ concept unique_any_traits =
  * (e.g. iconv, Win32 file HANDLEs) use `(some_ptr) -1` as the sentinel value.
  * Casting -1 to a pointer is never valid in constexpr, so we need this slightly
  * more verbose API.
+ *
+ * This is trivially relocatable if `storage_type` is, so containers that use
+ * `felly::relocate()` can grow with `memmove()`.
  */
 template <unique_any_traits TTraits>
-struct basic_unique_any {
+struct basic_unique_any FELLY_TRIVIALLY_RELOCATABLE_IF_ELIGIBLE {
   using value_type = TTraits::value_type;
   using storage_type = TTraits::storage_type;
 
@@ -411,8 +469,9 @@ struct basic_unique_any {
   }
 
   constexpr void require_value() const {
-    if (!has_value()) [[unlikely]] {
-      throw std::logic_error("Can't access a moved or invalid value");
+    if (FELLY_CHECK_FAILED(has_value())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Can't access a moved or invalid value");
     }
   }
 };
@@ -427,4 +486,21 @@ template <
 using unique_any =
   basic_unique_any<unique_any_default_traits<T, TDeleter, TPredicate>>;
 
+/// A `unique_any` with no storage overhead, using `TSentinel` as the empty
+/// value
+template <class T, auto TDeleter, auto TSentinel, auto TPredicate = nullptr>
+  requires felly_detail::nullptr_or_predicate<decltype(TPredicate), const T&>
+using unique_any_with_sentinel = basic_unique_any<
+  unique_any_sentinel_traits<T, TDeleter, TSentinel, TPredicate>>;
+
 }// namespace felly::inline unique_any_types
+
+namespace felly {
+
+// The only state is the storage, so the move constructor and destructor can be
+// skipped if they can be skipped for the storage
+template <class TTraits>
+struct is_trivially_relocatable<basic_unique_any<TTraits>>
+  : is_trivially_relocatable<typename TTraits::storage_type> {};
+
+}// namespace felly
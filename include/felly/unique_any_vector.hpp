@@ -0,0 +1,208 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "error_policy.hpp"
+#include "unique_any.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace felly_detail {
+
+template <class F, class T>
+concept unique_any_batch_deleter = std::same_as<F, std::nullptr_t>
+  || std::invocable<F, std::span<T>>
+  || std::invocable<F, std::size_t, T*>;
+
+}// namespace felly_detail
+
+namespace felly::inline unique_any_types {
+
+/** Owns many valid values that would otherwise be `basic_unique_any`s.
+ *
+ * Only the raw values are stored, contiguously, without the per-element
+ * storage or emptiness state of `basic_unique_any`; they are destroyed
+ * together by `clear()` or the destructor.
+ *
+ * If `TBatchDeleter` is provided, it is invoked once with all values, either
+ * as `TBatchDeleter(std::span<value_type>)` or as
+ * `TBatchDeleter(size, data)`; this is useful for APIs like
+ * `glDeleteTextures()`. Otherwise, values are destroyed one at a time with
+ * `TTraits::destroy()`.
+ */
+template <unique_any_traits TTraits, auto TBatchDeleter = nullptr>
+  requires felly_detail::unique_any_batch_deleter<
+    decltype(TBatchDeleter),
+    std::remove_const_t<typename TTraits::value_type>>
+class basic_unique_any_vector {
+ public:
+  using value_type = std::remove_const_t<typename TTraits::value_type>;
+  using element_type = basic_unique_any<TTraits>;
+  using size_type = std::size_t;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  static constexpr bool has_batch_deleter
+    = !std::same_as<decltype(TBatchDeleter), std::nullptr_t>;
+
+  basic_unique_any_vector() = default;
+  basic_unique_any_vector(const basic_unique_any_vector&) = delete;
+  basic_unique_any_vector& operator=(const basic_unique_any_vector&) = delete;
+
+  basic_unique_any_vector(basic_unique_any_vector&& other) noexcept
+    : mValues(std::exchange(other.mValues, {})) {}
+
+  basic_unique_any_vector& operator=(basic_unique_any_vector&& other) noexcept {
+    if (this == std::addressof(other)) {
+      return *this;
+    }
+    clear();
+    mValues = std::exchange(other.mValues, {});
+    return *this;
+  }
+
+  ~basic_unique_any_vector() {
+    clear();
+  }
+
+  /// Take ownership of the value from `v`, which must not be empty
+  void push_back(element_type&& v) {
+    reserve_one();
+    mValues.push_back(v.disown());
+  }
+
+  /** Take ownership of a raw value, which must be valid.
+   *
+   * Throws `std::invalid_argument` for invalid values; if this throws,
+   * ownership is not taken.
+   */
+  void adopt(value_type v) {
+    if (FELLY_CHECK_FAILED(TTraits::has_value(std::as_const(v))))
+      [[unlikely]] {
+      felly_detail::raise_error<std::invalid_argument>(
+        "Can't adopt an invalid value");
+    }
+    reserve_one();
+    mValues.push_back(std::move(v));
+  }
+
+  /// Remove the last value, returning ownership to the caller
+  [[nodiscard]]
+  element_type pop_back() {
+    require_value();
+    element_type ret {std::move(mValues.back())};
+    mValues.pop_back();
+    return ret;
+  }
+
+  /// Like `basic_unique_any::disown()`, for all values
+  [[nodiscard]]
+  std::vector<value_type> disown() noexcept {
+    return std::exchange(mValues, {});
+  }
+
+  /// Destroy all values; this is a single call if there is a batch deleter
+  void clear() noexcept {
+    if (mValues.empty()) {
+      return;
+    }
+    if constexpr (has_batch_deleter) {
+      const std::span<value_type> values {mValues};
+      if constexpr (std::invocable<
+                      decltype(TBatchDeleter),
+                      std::span<value_type>>) {
+        std::invoke(TBatchDeleter, values);
+      } else {
+        std::invoke(TBatchDeleter, values.size(), values.data());
+      }
+    } else {
+      for (auto&& value: mValues) {
+        typename TTraits::storage_type storage {TTraits::default_value()};
+        TTraits::construct(storage, std::move(value));
+        TTraits::destroy(storage);
+      }
+    }
+    mValues.clear();
+  }
+
+  void reserve(const size_type capacity) {
+    mValues.reserve(capacity);
+  }
+
+  [[nodiscard]]
+  size_type capacity() const noexcept {
+    return mValues.capacity();
+  }
+
+  [[nodiscard]]
+  size_type size() const noexcept {
+    return mValues.size();
+  }
+
+  [[nodiscard]]
+  bool empty() const noexcept {
+    return mValues.empty();
+  }
+
+  /** Always-const, for the same reasons as `basic_unique_any::get()`.
+   *
+   * Values are contiguous, so this can be passed to APIs that take arrays of
+   * handles.
+   */
+  [[nodiscard]]
+  std::span<const value_type> values() const noexcept {
+    return mValues;
+  }
+
+  [[nodiscard]]
+  const value_type& operator[](const size_type index) const noexcept {
+    return mValues[index];
+  }
+
+  [[nodiscard]]
+  const_iterator begin() const noexcept {
+    return mValues.begin();
+  }
+
+  [[nodiscard]]
+  const_iterator end() const noexcept {
+    return mValues.end();
+  }
+
+ private:
+  std::vector<value_type> mValues;
+
+  // Allocate before taking ownership, so that values aren't leaked if
+  // allocation fails
+  void reserve_one() {
+    if (mValues.size() == mValues.capacity()) {
+      mValues.reserve(std::max<size_type>(1, mValues.capacity() * 2));
+    }
+  }
+
+  void require_value() const {
+    if (FELLY_CHECK_FAILED(!mValues.empty())) [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Can't pop_back() an empty unique_any_vector");
+    }
+  }
+};
+
+template <
+  class T,
+  auto TDeleter = unique_any_default_delete<T>,
+  auto TPredicate = nullptr,
+  auto TBatchDeleter = nullptr>
+  requires felly_detail::nullptr_or_predicate<decltype(TPredicate), const T&>
+using unique_any_vector = basic_unique_any_vector<
+  unique_any_default_traits<T, TDeleter, TPredicate>,
+  TBatchDeleter>;
+
+}// namespace felly::inline unique_any_types
@@ -19,7 +19,8 @@ template <unique_any_traits TTraits>
     typename TTraits::value_type;
     requires std::is_pointer_v<typename TTraits::value_type>;
   }
-struct basic_unique_ptr : basic_unique_any<TTraits> {
+struct basic_unique_ptr FELLY_TRIVIALLY_RELOCATABLE_IF_ELIGIBLE
+  : basic_unique_any<TTraits> {
   using pointer = std::remove_const_t<typename TTraits::value_type>;
   using element_type = std::remove_pointer_t<pointer>;
 
@@ -40,6 +41,14 @@ using unique_ptr =
 
 }// namespace felly::inline unique_ptr_types
 
+namespace felly {
+
+template <class TTraits>
+struct is_trivially_relocatable<basic_unique_ptr<TTraits>>
+  : is_trivially_relocatable<basic_unique_any<TTraits>> {};
+
+}// namespace felly
+
 namespace std {
 /* Support `std::inout_ptr`
  *
@@ -0,0 +1,114 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+#include "error_policy.hpp"
+#include "guarded_data.hpp"
+#include "scope_exit.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <type_traits>
+
+namespace felly::inline waitable_guarded_data_types {
+
+/** A mutex with an associated condition variable.
+ *
+ * This is intended for use as the mutex type for `guarded_data`, adding
+ * `unique_guarded_data_lock::wait()` and `guarded_data::notify_one()`; the
+ * condition variable is only present when this type is used, so users of
+ * other mutex types don't pay for it.
+ *
+ * For `std::mutex`, this uses `std::condition_variable`; for other mutex types,
+ * this uses `std::condition_variable_any`.
+ */
+template <class TMutex = std::mutex>
+class waitable_mutex {
+ public:
+  waitable_mutex() = default;
+  waitable_mutex(const waitable_mutex&) = delete;
+  waitable_mutex& operator=(const waitable_mutex&) = delete;
+
+  void lock() { mMutex.lock(); }
+
+  [[nodiscard]]
+  bool try_lock() {
+    return mMutex.try_lock();
+  }
+
+  void unlock() { mMutex.unlock(); }
+
+  void notify_one() noexcept { mCondition.notify_one(); }
+  void notify_all() noexcept { mCondition.notify_all(); }
+
+  template <class TPredicate>
+  void wait(std::unique_lock<waitable_mutex>& lock, TPredicate&& pred) {
+    if constexpr (UsesConditionVariableAny) {
+      mCondition.wait(lock, std::forward<TPredicate>(pred));
+    } else {
+      auto inner = adopt(lock);
+      const scope_exit release {[&] { inner.release(); }};
+      mCondition.wait(inner, std::forward<TPredicate>(pred));
+    }
+  }
+
+  template <class Rep, class Period, class TPredicate>
+  bool wait_for(
+    std::unique_lock<waitable_mutex>& lock,
+    const std::chrono::duration<Rep, Period>& timeout,
+    TPredicate&& pred) {
+    if constexpr (UsesConditionVariableAny) {
+      return mCondition.wait_for(
+        lock, timeout, std::forward<TPredicate>(pred));
+    } else {
+      auto inner = adopt(lock);
+      const scope_exit release {[&] { inner.release(); }};
+      return mCondition.wait_for(
+        inner, timeout, std::forward<TPredicate>(pred));
+    }
+  }
+
+  template <class Clock, class Duration, class TPredicate>
+  bool wait_until(
+    std::unique_lock<waitable_mutex>& lock,
+    const std::chrono::time_point<Clock, Duration>& deadline,
+    TPredicate&& pred) {
+    if constexpr (UsesConditionVariableAny) {
+      return mCondition.wait_until(
+        lock, deadline, std::forward<TPredicate>(pred));
+    } else {
+      auto inner = adopt(lock);
+      const scope_exit release {[&] { inner.release(); }};
+      return mCondition.wait_until(
+        inner, deadline, std::forward<TPredicate>(pred));
+    }
+  }
+
+ private:
+  static constexpr bool UsesConditionVariableAny
+    = !std::same_as<TMutex, std::mutex>;
+
+  TMutex mMutex;
+  std::conditional_t<
+    UsesConditionVariableAny,
+    std::condition_variable_any,
+    std::condition_variable>
+    mCondition;
+
+  // `std::condition_variable` requires an `std::unique_lock<std::mutex>`;
+  // temporarily share ownership with one
+  std::unique_lock<TMutex> adopt(std::unique_lock<waitable_mutex>& lock) {
+    if (FELLY_CHECK_FAILED(lock.mutex() == this && lock.owns_lock()))
+      [[unlikely]] {
+      felly_detail::raise_error<std::logic_error>(
+        "Waiting with a lock for a different mutex");
+    }
+    return std::unique_lock {mMutex, std::adopt_lock};
+  }
+};
+
+template <class T, class TMutex = std::mutex>
+using waitable_guarded_data = guarded_data<T, waitable_mutex<TMutex>>;
+
+}// namespace felly::inline waitable_guarded_data_types
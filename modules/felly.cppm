@@ -0,0 +1,182 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+/* The `felly` named module, for `import felly;`
+ *
+ * This exports the same API as the headers; macros such as
+ * `FELLY_ERROR_POLICY` must be defined when building this module, and
+ * can not be changed by its importers.
+ */
+module;
+
+#include <felly/adaptive_mutex.hpp>
+#include <felly/async_guarded_data.hpp>
+#include <felly/channel.hpp>
+#include <felly/cold.hpp>
+#include <felly/error_policy.hpp>
+#include <felly/flat_combining_guarded_data.hpp>
+#include <felly/guarded_data.hpp>
+#include <felly/hardware_interference_size.hpp>
+#include <felly/instrumented_mutex.hpp>
+#include <felly/lazy_guarded.hpp>
+#include <felly/moved_flag.hpp>
+#include <felly/no_unique_address.hpp>
+#include <felly/non_copyable.hpp>
+#include <felly/numeric_cast.hpp>
+#include <felly/numeric_parse.hpp>
+#include <felly/object_pool.hpp>
+#include <felly/overload.hpp>
+#include <felly/per_thread.hpp>
+#include <felly/retain_ptr.hpp>
+#include <felly/scope_exit.hpp>
+#include <felly/seqlocked.hpp>
+#include <felly/sharded_guarded_data.hpp>
+#include <felly/snapshot_data.hpp>
+#include <felly/trivially_relocatable.hpp>
+#include <felly/unique_any.hpp>
+#include <felly/unique_any_vector.hpp>
+#include <felly/unique_ptr.hpp>
+#include <felly/version.hpp>
+#include <felly/waitable_guarded_data.hpp>
+
+export module felly;
+
+export namespace felly {
+// adaptive_mutex.hpp
+using felly::adaptive_mutex;
+using felly::basic_adaptive_mutex;
+
+// async_guarded_data.hpp
+using felly::async_guarded_data;
+using felly::async_mutex;
+
+// channel.hpp
+using felly::channel;
+using felly::channel_mode;
+using felly::spsc_channel;
+
+// flat_combining_guarded_data.hpp
+using felly::flat_combining_guarded_data;
+
+// guarded_data.hpp
+using felly::aligned_guarded_data;
+using felly::guarded_data;
+using felly::lock_all;
+using felly::shared_guarded_data;
+using felly::shared_guarded_data_lock;
+using felly::unique_guarded_data_lock;
+
+// hardware_interference_size.hpp
+using felly::hardware_constructive_interference_size;
+using felly::hardware_destructive_interference_size;
+
+// instrumented_mutex.hpp
+using felly::instrumented_guarded_data;
+using felly::instrumented_mutex;
+using felly::lock_stats;
+
+// lazy_guarded.hpp
+using felly::lazy_guarded;
+
+// moved_flag.hpp
+using felly::moved_flag;
+
+// non_copyable.hpp
+using felly::non_copyable;
+
+// numeric_cast.hpp
+using felly::numeric_cast;
+using felly::numeric_cast_element_error;
+using felly::numeric_cast_error;
+using felly::numeric_cast_range_error;
+using felly::saturate_cast;
+using felly::try_numeric_cast;
+
+// numeric_parse.hpp
+using felly::numeric_parse;
+using felly::numeric_parse_error;
+using felly::numeric_parse_field_error;
+using felly::numeric_parse_invalid_argument;
+using felly::numeric_parse_range_error;
+using felly::try_numeric_parse;
+
+// object_pool.hpp
+using felly::make_pooled;
+using felly::object_pool;
+using felly::pooled_ptr;
+
+// overload.hpp
+using felly::match;
+using felly::overload;
+using felly::visit;
+
+// per_thread.hpp
+using felly::per_thread;
+
+// retain_ptr.hpp
+using felly::adopt_ref;
+using felly::adopt_ref_t;
+using felly::retain_ptr;
+using felly::retain_ref;
+using felly::retain_ref_t;
+
+// scope_exit.hpp
+using felly::scope_exit;
+using felly::scope_exit_stack;
+using felly::scope_fail;
+using felly::scope_fail_stack;
+using felly::scope_success;
+using felly::scope_success_stack;
+
+// seqlocked.hpp
+using felly::seqlocked;
+using felly::seqlocked_write_lock;
+
+// sharded_guarded_data.hpp
+using felly::sharded_guarded_data;
+
+// snapshot_data.hpp
+using felly::snapshot;
+using felly::snapshot_data;
+
+// trivially_relocatable.hpp
+using felly::is_trivially_relocatable;
+using felly::is_trivially_relocatable_v;
+using felly::relocate;
+
+// unique_any.hpp
+using felly::basic_unique_any;
+using felly::unique_any;
+using felly::unique_any_default_delete;
+using felly::unique_any_default_traits;
+using felly::unique_any_optional_storage_traits;
+using felly::unique_any_pointer_traits;
+using felly::unique_any_sentinel_traits;
+using felly::unique_any_traits;
+using felly::unique_any_with_sentinel;
+
+// unique_any_vector.hpp
+using felly::basic_unique_any_vector;
+using felly::unique_any_vector;
+
+// unique_ptr.hpp
+using felly::basic_unique_ptr;
+using felly::unique_ptr;
+
+// waitable_guarded_data.hpp
+using felly::waitable_guarded_data;
+using felly::waitable_mutex;
+}// namespace felly
+
+export namespace felly::rounding {
+using felly::rounding::ceil;
+using felly::rounding::ceil_t;
+using felly::rounding::floor;
+using felly::rounding::floor_t;
+using felly::rounding::nearest_away;
+using felly::rounding::nearest_away_t;
+using felly::rounding::nearest_even;
+using felly::rounding::nearest_even_t;
+using felly::rounding::truncate;
+using felly::rounding::truncate_t;
+}// namespace felly::rounding
@@ -0,0 +1,71 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/adaptive_mutex.hpp>
+#include <felly/guarded_data.hpp>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST_CASE("adaptive_mutex") {
+  STATIC_CHECK(sizeof(felly::adaptive_mutex) == sizeof(std::uint32_t));
+
+  SECTION("lock and try_lock") {
+    felly::adaptive_mutex mutex;
+    CHECK(mutex.try_lock());
+    std::thread([&] { CHECK_FALSE(mutex.try_lock()); }).join();
+    mutex.unlock();
+
+    {
+      const std::lock_guard lock(mutex);
+      std::thread([&] { CHECK_FALSE(mutex.try_lock()); }).join();
+    }
+    CHECK(mutex.try_lock());
+    mutex.unlock();
+  }
+
+  SECTION("blocks until unlocked") {
+    felly::adaptive_mutex mutex;
+    mutex.lock();
+    std::atomic<bool> acquired {false};
+    std::thread waiter([&] {
+      const std::lock_guard lock(mutex);
+      acquired = true;
+    });
+    // Make it likely that the waiter has stopped spinning and is asleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK_FALSE(acquired);
+    mutex.unlock();
+    waiter.join();
+    CHECK(acquired);
+  }
+}
+
+TEST_CASE("adaptive_mutex with guarded_data") {
+  // Zero spins so that waiters go straight to sleep, and the
+  // wait/notify path is well exercised
+  using test_type = felly::
+    guarded_data<std::size_t, felly::basic_adaptive_mutex<0>>;
+  test_type counter(std::size_t {0});
+  constexpr std::size_t ThreadCount = 8;
+  constexpr std::size_t Iterations = 10000;
+
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t i = 0; i < ThreadCount; ++i) {
+      threads.emplace_back([&] {
+        for (std::size_t j = 0; j < Iterations; ++j) {
+          ++*counter.lock();
+        }
+      });
+    }
+  }
+  CHECK(*counter.lock() == ThreadCount * Iterations);
+
+  SECTION("try_lock") {
+    auto locked = counter.lock();
+    std::thread([&] { CHECK_FALSE(counter.try_lock()); }).join();
+  }
+}
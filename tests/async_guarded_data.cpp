@@ -0,0 +1,199 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/async_guarded_data.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Starts immediately, and is not awaitable
+struct fire_and_forget {
+  struct promise_type {
+    fire_and_forget get_return_object() noexcept {
+      return {};
+    }
+    std::suspend_never initial_suspend() noexcept {
+      return {};
+    }
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+      std::terminate();
+    }
+  };
+};
+
+struct queue_executor {
+  std::deque<std::coroutine_handle<>>* mQueue {nullptr};
+
+  void operator()(const std::coroutine_handle<> handle) const noexcept {
+    mQueue->push_back(handle);
+  }
+};
+
+struct throwing_executor {
+  void operator()(std::coroutine_handle<>) const {}
+};
+
+static_assert(felly_detail::async_executor<queue_executor>);
+static_assert(!felly_detail::async_executor<throwing_executor>);
+
+template <class TData, class... Args>
+fire_and_forget append(TData& data, int value, Args... args) {
+  auto lock = co_await data.lock(args...);
+  lock->push_back(value);
+}
+
+// Not a lambda, as captures would be destroyed with the lambda after the
+// first suspension
+fire_and_forget increment(
+  felly::async_guarded_data<int>& counter,
+  std::atomic<int>& done) {
+  auto lock = co_await counter.lock();
+  ++*lock;
+  done.fetch_add(1, std::memory_order_relaxed);
+}
+
+}// namespace
+
+TEST_CASE("async_guarded_data") {
+  felly::async_guarded_data<std::vector<int>> data;
+
+  SECTION("uncontended") {
+    append(data, 1);
+    append(data, 2);
+    const auto lock = data.try_lock();
+    REQUIRE(lock);
+    CHECK(*lock == std::vector {1, 2});
+  }
+
+  SECTION("try_lock") {
+    auto lock = data.try_lock();
+    CHECK(lock);
+    CHECK_FALSE(data.try_lock());
+    lock.unlock();
+    CHECK(data.try_lock());
+  }
+
+  SECTION("contended") {
+    auto lock = data.try_lock();
+    REQUIRE(lock);
+    append(data, 1);
+    append(data, 2);
+    append(data, 3);
+    // All suspended
+    CHECK(lock->empty());
+    lock->push_back(0);
+
+    // Waiters are resumed in order, on this thread
+    lock.unlock();
+    const auto after = data.try_lock();
+    REQUIRE(after);
+    CHECK(*after == std::vector {0, 1, 2, 3});
+  }
+
+  SECTION("waiters added while others are queued") {
+    auto lock = data.try_lock();
+    REQUIRE(lock);
+    std::deque<std::coroutine_handle<>> queue;
+    const queue_executor executor {&queue};
+    append(data, 1, executor);
+    append(data, 2, executor);
+    lock.unlock();
+    REQUIRE(queue.size() == 1);
+    append(data, 3, executor);
+    while (!queue.empty()) {
+      const auto next = queue.front();
+      queue.pop_front();
+      next.resume();
+    }
+    const auto after = data.try_lock();
+    REQUIRE(after);
+    CHECK(*after == std::vector {1, 2, 3});
+  }
+
+  SECTION("long queue") {
+    // Each waiter unlocks without suspending, which would overflow the stack
+    // if each resumed the next one recursively
+    constexpr int Count = 100000;
+    felly::async_guarded_data<int> counter {0};
+    std::atomic<int> done {0};
+    auto lock = counter.try_lock();
+    for (int i = 0; i < Count; ++i) {
+      increment(counter, done);
+    }
+    CHECK(done == 0);
+    lock.unlock();
+    CHECK(done == Count);
+    CHECK(*counter.try_lock() == Count);
+  }
+
+  SECTION("executor") {
+    auto lock = data.try_lock();
+    REQUIRE(lock);
+    std::deque<std::coroutine_handle<>> queue;
+    append(data, 1, queue_executor {&queue});
+    CHECK(queue.empty());
+
+    lock.unlock();
+    // Not resumed yet, but the lock has been handed over
+    REQUIRE(queue.size() == 1);
+    CHECK_FALSE(data.try_lock());
+
+    queue.front().resume();
+    const auto after = data.try_lock();
+    REQUIRE(after);
+    CHECK(*after == std::vector {1});
+  }
+
+  SECTION("executor is not used if uncontended") {
+    std::deque<std::coroutine_handle<>> queue;
+    append(data, 1, queue_executor {&queue});
+    CHECK(queue.empty());
+    CHECK(*data.try_lock() == std::vector {1});
+  }
+
+  SECTION("const") {
+    append(data, 1);
+    const auto& constData = data;
+    std::size_t size {};
+    // Safe as a lambda, as this never suspends
+    [&]() -> fire_and_forget {
+      const auto lock = co_await constData.lock();
+      STATIC_CHECK(std::is_const_v<std::remove_reference_t<decltype(*lock)>>);
+      size = lock->size();
+    }();
+    CHECK(size == 1);
+  }
+}
+
+TEST_CASE("async_guarded_data - threads") {
+  constexpr int ThreadCount = 4;
+  constexpr int PerThread = 10000;
+
+  felly::async_guarded_data<int> counter {0};
+  std::atomic<int> done {0};
+  {
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < ThreadCount; ++i) {
+      threads.emplace_back([&] {
+        for (int j = 0; j < PerThread; ++j) {
+          increment(counter, done);
+        }
+      });
+    }
+  }
+  // With the default executor, suspended coroutines are resumed by the thread
+  // that unlocks, so all have finished once the threads have
+  CHECK(done == ThreadCount * PerThread);
+  CHECK(*counter.try_lock() == ThreadCount * PerThread);
+}
@@ -0,0 +1,164 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <felly/channel.hpp>
+#include <felly/non_copyable.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using felly::channel_mode;
+
+namespace {
+
+struct MoveOnly : felly::non_copyable {
+  static inline int live = 0;
+
+  explicit MoveOnly(const int value) : value(std::make_unique<int>(value)) {
+    ++live;
+  }
+  MoveOnly(MoveOnly&& other) noexcept : value(std::move(other.value)) {
+    ++live;
+  }
+  MoveOnly& operator=(MoveOnly&&) noexcept = default;
+  ~MoveOnly() {
+    --live;
+  }
+
+  std::unique_ptr<int> value;
+};
+
+}// namespace
+
+TEMPLATE_TEST_CASE(
+  "channel",
+  "",
+  (felly::spsc_channel<int, 4>),
+  (felly::channel<int, 4>),
+  (felly::channel<int, 3>)) {
+  TestType channel;
+  constexpr auto Capacity = TestType::capacity();
+
+  SECTION("empty") {
+    CHECK(channel.try_pop() == std::nullopt);
+  }
+
+  SECTION("FIFO") {
+    for (int i = 0; i < static_cast<int>(Capacity); ++i) {
+      CHECK(channel.try_push(i));
+    }
+    CHECK_FALSE(channel.try_push(123));
+    for (int i = 0; i < static_cast<int>(Capacity); ++i) {
+      CHECK(channel.try_pop() == i);
+    }
+    CHECK(channel.try_pop() == std::nullopt);
+  }
+
+  SECTION("wraps around") {
+    for (int i = 0; i < 100; ++i) {
+      CHECK(channel.try_push(i));
+      CHECK(channel.try_push(i * 2));
+      CHECK(channel.pop() == i);
+      CHECK(channel.pop() == i * 2);
+    }
+  }
+
+  SECTION("pop_n") {
+    for (int i = 0; i < 3; ++i) {
+      channel.push(i);
+    }
+    std::vector<int> out;
+    CHECK(channel.try_pop_n(std::back_inserter(out), 2) == 2);
+    CHECK(out == std::vector {0, 1});
+    CHECK(channel.pop_n(std::back_inserter(out), 2) == 1);
+    CHECK(out == std::vector {0, 1, 2});
+    CHECK(channel.try_pop_n(std::back_inserter(out), 2) == 0);
+    CHECK(channel.pop_n(std::back_inserter(out), 0) == 0);
+  }
+
+  SECTION("blocking") {
+    constexpr int Count = 10000;
+    std::jthread producer {[&] {
+      for (int i = 0; i < Count; ++i) {
+        channel.push(i);
+      }
+    }};
+    std::int64_t sum = 0;
+    for (int i = 0; i < Count; ++i) {
+      const auto value = channel.pop();
+      CHECK(value == i);
+      sum += value;
+    }
+    CHECK(sum == std::int64_t {Count} * (Count - 1) / 2);
+  }
+}
+
+TEMPLATE_TEST_CASE(
+  "channel with move-only values",
+  "",
+  (felly::spsc_channel<MoveOnly, 4>),
+  (felly::channel<MoveOnly, 4>)) {
+  {
+    TestType channel;
+    MoveOnly first {1};
+    CHECK(channel.try_push(std::move(first)));
+    CHECK_FALSE(first.value);
+    channel.emplace(2);
+    channel.push(MoveOnly {3});
+    channel.emplace(4);
+
+    MoveOnly rejected {5};
+    CHECK_FALSE(channel.try_push(std::move(rejected)));
+    // Not moved from on failure
+    CHECK(rejected.value);
+
+    const auto popped = channel.try_pop();
+    REQUIRE(popped);
+    CHECK(*popped->value == 1);
+    CHECK(*channel.pop().value == 2);
+    // Two remaining in the channel, `first`, `rejected`, and `popped`
+    CHECK(MoveOnly::live == 5);
+  }
+  // Remaining values are destroyed with the channel
+  CHECK(MoveOnly::live == 0);
+}
+
+TEST_CASE("channel - multiple producers and consumers") {
+  constexpr int ThreadCount = 4;
+  constexpr int PerThread = 10000;
+
+  felly::channel<int, 16> channel;
+  std::vector<std::int64_t> sums(ThreadCount);
+  {
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < ThreadCount; ++i) {
+      threads.emplace_back([&channel] {
+        for (int j = 0; j < PerThread; ++j) {
+          channel.push(j);
+        }
+      });
+      threads.emplace_back([&channel, &sum = sums.at(i)] {
+        std::vector<int> batch;
+        for (int received = 0; received < PerThread;) {
+          batch.clear();
+          received += static_cast<int>(channel.pop_n(
+            std::back_inserter(batch), PerThread - received));
+          for (auto value: batch) {
+            sum += value;
+          }
+        }
+      });
+    }
+  }
+  std::int64_t total = 0;
+  for (auto sum: sums) {
+    total += sum;
+  }
+  CHECK(total == std::int64_t {ThreadCount} * PerThread * (PerThread - 1) / 2);
+  CHECK(channel.try_pop() == std::nullopt);
+}
@@ -0,0 +1,26 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/error_policy.hpp>
+
+#include <stdexcept>
+#include <string_view>
+
+static_assert(FELLY_HAS_EXCEPTIONS);
+static_assert(FELLY_ERROR_POLICY == FELLY_ERROR_POLICY_THROW);
+
+TEST_CASE("error_policy") {
+  SECTION("FELLY_CHECK_FAILED") {
+    STATIC_CHECK(FELLY_CHECK_FAILED(false));
+    STATIC_CHECK_FALSE(FELLY_CHECK_FAILED(true));
+  }
+
+  SECTION("raise_error") {
+    try {
+      felly_detail::raise_error<std::invalid_argument>("test message");
+    } catch (const std::invalid_argument& e) {
+      CHECK(std::string_view {e.what()} == "test message");
+    }
+  }
+}
@@ -0,0 +1,91 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <felly/adaptive_mutex.hpp>
+#include <felly/flat_combining_guarded_data.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace felly::flat_combining_guarded_data_types;
+
+TEMPLATE_TEST_CASE(
+  "flat_combining_guarded_data",
+  "",
+  std::mutex,
+  felly::adaptive_mutex) {
+  SECTION("single-threaded") {
+    flat_combining_guarded_data<int, TestType> counter {123};
+    CHECK(counter.with_lock([](int& v) { return v; }) == 123);
+    counter.with_lock([](int& v) { v = 456; });
+    CHECK(counter.with_lock([](const int& v) { return v * 2; }) == 912);
+  }
+
+  SECTION("move-only result") {
+    flat_combining_guarded_data<int, TestType> counter {123};
+    const auto ret
+      = counter.with_lock([](int& v) { return std::make_unique<int>(v); });
+    REQUIRE(ret);
+    CHECK(*ret == 123);
+  }
+
+  SECTION("exception") {
+    flat_combining_guarded_data<int, TestType> counter {0};
+    CHECK_THROWS_AS(
+      counter.with_lock([](int&) -> int { throw std::runtime_error("test"); }),
+      std::runtime_error);
+    // Still usable
+    CHECK(counter.with_lock([](int& v) { return ++v; }) == 1);
+  }
+
+  SECTION("multi-threaded") {
+    constexpr std::size_t ThreadCount = 8;
+    constexpr std::size_t Iterations = 10000;
+
+    flat_combining_guarded_data<std::vector<std::size_t>, TestType> data;
+    std::vector<std::size_t> sums(ThreadCount);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < ThreadCount; ++i) {
+      threads.emplace_back([&, i] {
+        for (std::size_t j = 0; j < Iterations; ++j) {
+          sums[i] += data.with_lock([](auto& v) {
+            v.push_back(v.size());
+            return v.back();
+          });
+        }
+      });
+    }
+    for (auto&& thread: threads) {
+      thread.join();
+    }
+
+    // Each caller got back the result of its own invocation
+    constexpr auto Total = ThreadCount * Iterations;
+    std::size_t sum = 0;
+    for (auto&& it: sums) {
+      sum += it;
+    }
+    CHECK(sum == (Total * (Total - 1)) / 2);
+    CHECK(data.with_lock([](auto& v) { return v.size(); }) == Total);
+  }
+
+  SECTION("more threads than slots") {
+    flat_combining_guarded_data<int, TestType, 1> counter {0};
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i) {
+      threads.emplace_back([&] {
+        for (std::size_t j = 0; j < 1000; ++j) {
+          counter.with_lock([](int& v) { ++v; });
+        }
+      });
+    }
+    for (auto&& thread: threads) {
+      thread.join();
+    }
+    CHECK(counter.with_lock([](int& v) { return v; }) == 4000);
+  }
+}
@@ -114,3 +114,237 @@ TEST_CASE("guarded_data move semantics", "[guarded_data]") {
     CHECK(!lock3);
   }
 }
+
+TEST_CASE("shared_guarded_data", "[guarded_data]") {
+  SECTION("static checks") {
+    using test_type = shared_guarded_data<int>;
+    STATIC_CHECK(
+      std::same_as<
+        decltype(std::declval<test_type&>().lock_shared().get()),
+        const int&>);
+    STATIC_CHECK(
+      std::same_as<
+        decltype(std::declval<const test_type&>().lock_shared().get()),
+        const int&>);
+    STATIC_CHECK(
+      std::same_as<
+        decltype(std::declval<test_type&>().lock_shared().upgrade().get()),
+        int&>);
+    STATIC_CHECK(
+      std::same_as<
+        decltype(std::declval<const test_type&>()
+                   .lock_shared()
+                   .upgrade()
+                   .get()),
+        const int&>);
+  }
+
+  SECTION("exclusive lock") {
+    shared_guarded_data<std::string> guarded("Hello");
+    auto locked = guarded.lock();
+    locked->append(" World");
+    CHECK(*locked == "Hello World");
+  }
+
+  SECTION("concurrent shared locks") {
+    const shared_guarded_data<int> guarded(123);
+    auto locked = guarded.lock_shared();
+    CHECK(*locked == 123);
+
+    int value {};
+    std::thread([&] { value = *guarded.lock_shared(); }).join();
+    CHECK(value == 123);
+  }
+
+  SECTION("manual unlock") {
+    shared_guarded_data<int> guarded(123);
+    auto locked = guarded.lock_shared();
+    CHECK(locked);
+    locked.unlock();
+    CHECK_FALSE(locked);
+    CHECK_THROWS(locked.unlock());
+
+    // Would deadlock if the shared lock were still held
+    CHECK(*guarded.lock() == 123);
+  }
+
+  SECTION("upgrade and downgrade") {
+    shared_guarded_data<int> guarded(123);
+    auto shared = guarded.lock_shared();
+    CHECK(*shared == 123);
+
+    auto exclusive = std::move(shared).upgrade();
+    CHECK_FALSE(shared);
+    CHECK(exclusive);
+    *exclusive = 456;
+
+    auto downgraded = std::move(exclusive).downgrade();
+    CHECK_FALSE(exclusive);
+    CHECK(downgraded);
+    CHECK(*downgraded == 456);
+
+    int value {};
+    std::thread([&] { value = *guarded.lock_shared(); }).join();
+    CHECK(value == 456);
+
+    downgraded.unlock();
+    CHECK_THROWS(std::move(downgraded).upgrade());
+  }
+}
+
+TEST_CASE("guarded_data try_lock", "[guarded_data]") {
+  guarded_data<int> guarded(123);
+  const auto& const_guarded = guarded;
+
+  SECTION("uncontended") {
+    auto locked = guarded.try_lock();
+    REQUIRE(locked);
+    CHECK(*locked == 123);
+    *locked = 456;
+    locked.unlock();
+
+    auto const_locked = const_guarded.try_lock();
+    REQUIRE(const_locked);
+    STATIC_CHECK(std::same_as<decltype(const_locked.get()), const int&>);
+    CHECK(*const_locked == 456);
+  }
+
+  SECTION("contended") {
+    auto locked = guarded.lock();
+    std::thread([&] {
+      CHECK_FALSE(guarded.try_lock());
+      CHECK_FALSE(const_guarded.try_lock());
+    }).join();
+    locked.unlock();
+    std::thread([&] { CHECK(guarded.try_lock()); }).join();
+  }
+
+  SECTION("empty lock can't be unlocked") {
+    auto locked = guarded.lock();
+    std::thread([&] {
+      auto failed = guarded.try_lock();
+      CHECK_FALSE(failed);
+      CHECK_THROWS(failed.unlock());
+    }).join();
+  }
+}
+
+TEST_CASE("guarded_data with_lock", "[guarded_data]") {
+  guarded_data<std::string> guarded("Hello");
+  const auto& const_guarded = guarded;
+
+  guarded.with_lock([](auto& v) { v += " World"; });
+  CHECK(const_guarded.with_lock([](auto& v) { return v.size(); }) == 11);
+
+  // Returns a copy, not a reference to the guarded data
+  decltype(auto) copy = guarded.with_lock([](auto& v) -> auto& { return v; });
+  STATIC_CHECK(std::same_as<decltype(copy), std::string>);
+  CHECK(copy == "Hello World");
+
+  // Not held afterwards
+  std::thread([&] { CHECK(guarded.try_lock()); }).join();
+}
+
+TEST_CASE("guarded_data timed locks", "[guarded_data]") {
+  using namespace std::chrono_literals;
+  guarded_data<int, std::timed_mutex> guarded(123);
+  const auto& const_guarded = guarded;
+
+  SECTION("uncontended") {
+    CHECK(*guarded.try_lock_for(1ms) == 123);
+    CHECK(*const_guarded.try_lock_for(1ms) == 123);
+    const auto deadline = std::chrono::steady_clock::now() + 1ms;
+    CHECK(*guarded.try_lock_until(deadline) == 123);
+    CHECK(*const_guarded.try_lock_until(deadline) == 123);
+  }
+
+  SECTION("contended") {
+    auto locked = guarded.lock();
+    std::thread([&] {
+      CHECK_FALSE(guarded.try_lock_for(1ms));
+      CHECK_FALSE(const_guarded.try_lock_for(1ms));
+      const auto deadline = std::chrono::steady_clock::now() + 1ms;
+      CHECK_FALSE(guarded.try_lock_until(deadline));
+      CHECK_FALSE(const_guarded.try_lock_until(deadline));
+    }).join();
+  }
+}
+
+TEST_CASE("shared_guarded_data try_lock_shared", "[guarded_data]") {
+  shared_guarded_data<int> guarded(123);
+
+  SECTION("with shared lock held") {
+    auto shared = guarded.lock_shared();
+    std::thread([&] {
+      CHECK(guarded.try_lock_shared());
+      CHECK_FALSE(guarded.try_lock());
+    }).join();
+  }
+
+  SECTION("with exclusive lock held") {
+    auto exclusive = guarded.lock();
+    std::thread([&] {
+      CHECK_FALSE(guarded.try_lock_shared());
+      CHECK_FALSE(std::as_const(guarded).try_lock_shared());
+    }).join();
+  }
+}
+
+TEST_CASE("lock_all", "[guarded_data]") {
+  guarded_data<std::vector<int>> a {1, 2, 3};
+  guarded_data<std::vector<int>> b {};
+
+  SECTION("locks all") {
+    auto [from, to] = lock_all(a, b);
+    STATIC_CHECK(
+      std::same_as<decltype(from), unique_guarded_data_lock<std::vector<int>>>);
+    CHECK(from);
+    CHECK(to);
+    to->push_back(from->back());
+    from->pop_back();
+    std::thread([&] {
+      CHECK_FALSE(a.try_lock());
+      CHECK_FALSE(b.try_lock());
+    }).join();
+    from.unlock();
+    to.unlock();
+
+    CHECK(*a.lock() == std::vector {1, 2});
+    CHECK(*b.lock() == std::vector {3});
+  }
+
+  SECTION("mixed const and mutex types") {
+    const guarded_data<int, std::recursive_mutex> c(123);
+    shared_guarded_data<int> d(456);
+    auto [aLock, cLock, dLock] = lock_all(a, c, d);
+    STATIC_CHECK(std::same_as<decltype(cLock.get()), const int&>);
+    STATIC_CHECK(std::same_as<decltype(dLock.get()), int&>);
+    CHECK(aLock->size() == 3);
+    CHECK(*cLock == 123);
+    CHECK(*dLock == 456);
+  }
+
+  SECTION("argument order does not cause deadlocks") {
+    constexpr int Iterations = 10000;
+    std::jthread forwards([&] {
+      for (int i = 0; i < Iterations; ++i) {
+        auto [from, to] = lock_all(a, b);
+        if (from->empty()) {
+          continue;
+        }
+        to->push_back(from->back());
+        from->pop_back();
+      }
+    });
+    std::jthread backwards([&] {
+      for (int i = 0; i < Iterations; ++i) {
+        auto [from, to] = lock_all(b, a);
+        if (from->empty()) {
+          continue;
+        }
+        to->push_back(from->back());
+        from->pop_back();
+      }
+    });
+  }
+}
@@ -0,0 +1,115 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/instrumented_mutex.hpp>
+
+#include <shared_mutex>
+#include <thread>
+
+using namespace std::chrono_literals;
+using namespace felly::guarded_data_types;
+using namespace felly::instrumented_mutex_types;
+
+namespace {
+template <class T>
+concept has_stats = requires(const T& v) { v.stats(); };
+
+template <class T>
+concept shared_lockable = requires(T& v) { v.lock_shared(); };
+
+template <class T>
+concept timed_lockable = requires(T& v) { v.try_lock_for(1ms); };
+}// namespace
+
+TEST_CASE("instrumented_mutex static checks") {
+  STATIC_CHECK_FALSE(has_stats<guarded_data<int>>);
+  STATIC_CHECK(has_stats<instrumented_guarded_data<int>>);
+
+  STATIC_CHECK_FALSE(shared_lockable<instrumented_guarded_data<int>>);
+  STATIC_CHECK(
+    shared_lockable<instrumented_guarded_data<int, std::shared_mutex>>);
+
+  STATIC_CHECK_FALSE(timed_lockable<instrumented_mutex<>>);
+  STATIC_CHECK(timed_lockable<instrumented_mutex<std::timed_mutex>>);
+}
+
+TEST_CASE("instrumented_mutex") {
+  SECTION("name") {
+    instrumented_mutex<> unnamed;
+    CHECK(unnamed.stats().name.empty());
+
+    instrumented_mutex<> named {"test"};
+    CHECK(named.stats().name == "test");
+  }
+
+  SECTION("uncontended") {
+    instrumented_mutex<> mutex;
+    mutex.lock();
+    mutex.unlock();
+    CHECK(mutex.try_lock());
+    mutex.unlock();
+
+    const auto stats = mutex.stats();
+    CHECK(stats.acquisitions == 2);
+    CHECK(stats.contended_acquisitions == 0);
+    CHECK(stats.total_wait == 0ns);
+    CHECK(stats.max_hold <= stats.total_hold);
+  }
+
+  SECTION("failed try_lock is not an acquisition") {
+    instrumented_mutex<> mutex;
+    mutex.lock();
+    std::thread([&] { CHECK_FALSE(mutex.try_lock()); }).join();
+    mutex.unlock();
+    CHECK(mutex.stats().acquisitions == 1);
+  }
+
+  SECTION("contended") {
+    instrumented_mutex<> mutex;
+    mutex.lock();
+    std::thread waiter([&] {
+      mutex.lock();
+      mutex.unlock();
+    });
+    std::this_thread::sleep_for(10ms);
+    mutex.unlock();
+    waiter.join();
+
+    const auto stats = mutex.stats();
+    CHECK(stats.acquisitions == 2);
+    CHECK(stats.contended_acquisitions == 1);
+    CHECK(stats.max_wait > 0ns);
+    CHECK(stats.max_wait == stats.total_wait);
+    CHECK(stats.max_hold >= 10ms);
+  }
+
+  SECTION("shared") {
+    instrumented_mutex<std::shared_mutex> mutex;
+    mutex.lock_shared();
+    CHECK(mutex.try_lock_shared());
+    mutex.unlock_shared();
+    mutex.unlock_shared();
+
+    const auto stats = mutex.stats();
+    CHECK(stats.acquisitions == 2);
+    CHECK(stats.total_hold == 0ns);
+  }
+}
+
+TEST_CASE("instrumented_guarded_data") {
+  instrumented_guarded_data<int> counter {
+    std::piecewise_construct,
+    std::forward_as_tuple("counter"),
+    std::forward_as_tuple(123)};
+  CHECK(*counter.lock() == 123);
+  {
+    auto lock = counter.lock();
+    *lock = 456;
+  }
+  CHECK(*counter.lock() == 456);
+
+  const auto stats = counter.stats();
+  CHECK(stats.name == "counter");
+  CHECK(stats.acquisitions == 3);
+}
@@ -0,0 +1,131 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/lazy_guarded.hpp>
+
+#include <any>
+#include <atomic>
+#include <concepts>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+using felly::lazy_guarded;
+
+TEST_CASE("lazy_guarded") {
+  lazy_guarded<std::string> lazy;
+  int calls = 0;
+  const auto init = [&] {
+    ++calls;
+    return std::string {"foo"};
+  };
+
+  SECTION("uninitialized") {
+    CHECK(lazy.get() == nullptr);
+    CHECK_FALSE(lazy.lock());
+    CHECK_FALSE(std::as_const(lazy).lock());
+  }
+
+  SECTION("get_or_init") {
+    const auto& value = lazy.get_or_init(init);
+    CHECK(value == "foo");
+    CHECK(calls == 1);
+    CHECK(&lazy.get_or_init(init) == &value);
+    CHECK(lazy.get() == &value);
+    CHECK(calls == 1);
+  }
+
+  SECTION("lock") {
+    // Modifying the value would race with `get()` and `get_or_init()`
+    STATIC_CHECK(
+      std::same_as<
+        decltype(lazy.lock()),
+        felly::unique_guarded_data_lock<const std::string, std::mutex>>);
+
+    std::ignore = lazy.get_or_init(init);
+    const auto lock = lazy.lock();
+    REQUIRE(lock);
+    CHECK(*lock == "foo");
+    CHECK(&*lock == lazy.get());
+  }
+
+#if FELLY_HAS_EXCEPTIONS
+  SECTION("throwing initializer") {
+    CHECK_THROWS_AS(
+      lazy.get_or_init([]() -> std::string { throw std::runtime_error("x"); }),
+      std::runtime_error);
+    CHECK(lazy.get() == nullptr);
+    CHECK(lazy.get_or_init(init) == "foo");
+  }
+#endif
+
+  SECTION("immovable") {
+    lazy_guarded<std::mutex> mutex;
+    const auto& value = mutex.get_or_init([] { return std::mutex {}; });
+    CHECK(mutex.get() == &value);
+  }
+
+  SECTION("converting constructor") {
+    // `std::any` can be constructed from anything, but should be initialized
+    // with the result of `f()`, not a wrapper
+    lazy_guarded<std::any> any;
+    const auto& value = any.get_or_init([] { return std::any {42}; });
+    REQUIRE(value.type() == typeid(int));
+    CHECK(std::any_cast<int>(value) == 42);
+
+    lazy_guarded<std::any> converted;
+    CHECK(std::any_cast<int>(converted.get_or_init([] { return 123; })) == 123);
+  }
+}
+
+TEST_CASE("lazy_guarded - threads") {
+  constexpr int ThreadCount = 8;
+
+  lazy_guarded<std::vector<int>> lazy;
+  std::atomic<int> calls {0};
+  std::atomic<int> sum {0};
+  {
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < ThreadCount; ++i) {
+      threads.emplace_back([&] {
+        const auto& value = lazy.get_or_init([&] {
+          ++calls;
+          return std::vector {1, 2, 3};
+        });
+        for (const auto it: value) {
+          sum += it;
+        }
+      });
+    }
+  }
+  CHECK(calls == 1);
+  CHECK(sum == 6 * ThreadCount);
+}
+
+// Previously, `lock()` allowed modifying the value while other threads were
+// reading it without locking; this is a data race, which TSan reports
+TEST_CASE("lazy_guarded - lock() with concurrent readers") {
+  constexpr int Iterations = 10000;
+
+  lazy_guarded<std::vector<int>> lazy;
+  std::ignore = lazy.get_or_init([] { return std::vector {1, 2, 3}; });
+
+  std::atomic<int> sum {0};
+  {
+    std::jthread reader {[&] {
+      for (int i = 0; i < Iterations; ++i) {
+        sum += lazy.get()->back();
+      }
+    }};
+    std::jthread locker {[&] {
+      for (int i = 0; i < Iterations; ++i) {
+        sum += lazy.lock()->back();
+      }
+    }};
+  }
+  CHECK(sum == 2 * 3 * Iterations);
+}
@@ -0,0 +1,36 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+// Only built if `FELLY_BUILD_MODULE` is enabled; the API is covered by the
+// header tests, so this just checks that it is exported.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+
+import felly;
+
+TEST_CASE("import felly") {
+  felly::guarded_data<int> counter {0};
+  *counter.lock() += 1;
+  CHECK(*counter.lock() == 1);
+
+  // The shard type documented by `sharded_guarded_data`
+  felly::aligned_guarded_data<int> shard {0};
+  CHECK(*shard.lock() == 0);
+
+  CHECK(felly::numeric_cast<int>(2.5, felly::rounding::nearest_even) == 2);
+  CHECK_THROWS_AS(
+    felly::numeric_cast<unsigned char>(-1), felly::numeric_cast_range_error);
+
+  int count = 0;
+  {
+    felly::scope_exit_stack<1> stack;
+    stack.push([&] { ++count; });
+    stack.push([&] { ++count; });
+  }
+  CHECK(count == 2);
+
+  const felly::unique_ptr<int, [](int* p) { delete p; }> p {new int {123}};
+  CHECK(*p == 123);
+}
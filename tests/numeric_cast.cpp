@@ -5,7 +5,13 @@
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include <felly/numeric_cast.hpp>
 
+#include <array>
+#include <cmath>
 #include <limits>
+#include <string_view>
+#include <tuple>
+#include <variant>
+#include <vector>
 
 using namespace felly;
 
@@ -126,3 +132,376 @@ TEST_CASE(
   constexpr auto Low = std::numeric_limits<int32_t>::lowest();
   CHECK(numeric_cast<float>(Low) == Low);
 }
+
+TEST_CASE("numeric_cast: ranges", "[numeric_cast][range]") {
+  SECTION("in range") {
+    // Larger than a block, and not a multiple of the block size
+    std::vector<int64_t> in(1000);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+      in[i] = static_cast<int64_t>(i) - 500;
+    }
+    std::vector<int32_t> out(in.size());
+    numeric_cast<int32_t>(in, out);
+    CHECK(out.front() == -500);
+    CHECK(out.back() == 499);
+  }
+
+  SECTION("empty") {
+    std::vector<double> in;
+    std::vector<float> out;
+    CHECK_NOTHROW(numeric_cast<float>(in, out));
+  }
+
+  SECTION("size mismatch") {
+    std::vector<double> in(2);
+    std::vector<float> out(1);
+    CHECK_THROWS_AS(numeric_cast<float>(in, out), std::invalid_argument);
+  }
+
+  SECTION("NaN") {
+    const std::array in {1.0, 2.0, std::numeric_limits<double>::quiet_NaN()};
+    std::array<float, 3> floats {};
+    numeric_cast<float>(in, floats);
+    CHECK(floats[1] == 2.0f);
+    CHECK(std::isnan(floats[2]));
+
+    std::array<int, 3> ints {};
+    CHECK_THROWS_AS(numeric_cast<int>(in, ints), numeric_cast_element_error);
+  }
+
+  SECTION("reports the first out of range element") {
+    std::vector<double> in(1000, 1.0);
+    in[700] = 1e20;
+    in[800] = -1e20;
+    std::vector<int32_t> out(in.size());
+    try {
+      numeric_cast<int32_t>(in, out);
+      FAIL("Expected an exception");
+    } catch (const numeric_cast_element_error& e) {
+      CHECK(e.index() == 700);
+      CHECK_THAT(e.what(), Catch::Matchers::StartsWith("Element 700: "));
+    }
+  }
+}
+
+TEST_CASE("try_numeric_cast", "[numeric_cast][try]") {
+  using enum numeric_cast_error;
+
+  SECTION("in range") {
+    STATIC_CHECK(try_numeric_cast<int32_t>(int64_t {123}) == 123);
+    STATIC_CHECK(try_numeric_cast<uint8_t>(255u) == 255);
+    STATIC_CHECK(try_numeric_cast<float>(1.5) == 1.5f);
+    STATIC_CHECK(try_numeric_cast<double>(-1) == -1.0);
+    STATIC_CHECK(try_numeric_cast<int>(-1.5) == -1);
+    STATIC_CHECK(noexcept(try_numeric_cast<int>(1.5)));
+  }
+
+  SECTION("Integral to Integral") {
+    constexpr auto Max = std::numeric_limits<int32_t>::max();
+    constexpr auto Lowest = std::numeric_limits<int32_t>::lowest();
+    STATIC_CHECK(
+      try_numeric_cast<int32_t>(int64_t {Max} + 1)
+      == std::unexpected {TooHigh});
+    STATIC_CHECK(
+      try_numeric_cast<int32_t>(int64_t {Lowest} - 1)
+      == std::unexpected {TooLow});
+    STATIC_CHECK(try_numeric_cast<uint32_t>(-1) == std::unexpected {TooLow});
+  }
+
+  SECTION("Floating Point to Floating Point") {
+    constexpr auto Max = static_cast<double>(std::numeric_limits<float>::max());
+    STATIC_CHECK(
+      try_numeric_cast<float>(Max * 2) == std::unexpected {TooHigh});
+    STATIC_CHECK(
+      try_numeric_cast<float>(Max * -2) == std::unexpected {TooLow});
+    const auto nan = try_numeric_cast<float>(NAN);
+    REQUIRE(nan.has_value());
+    CHECK(std::isnan(*nan));
+  }
+
+  SECTION("Float to Integral") {
+    constexpr auto Max = std::numeric_limits<uint32_t>::max();
+    STATIC_CHECK(
+      try_numeric_cast<uint32_t>(static_cast<double>(Max)) == Max);
+    // Not representable; rounds up to 2^32
+    STATIC_CHECK(
+      try_numeric_cast<uint32_t>(static_cast<float>(Max))
+      == std::unexpected {TooHigh});
+    STATIC_CHECK(try_numeric_cast<uint32_t>(-1.0) == std::unexpected {TooLow});
+    CHECK(
+      try_numeric_cast<int>(std::numeric_limits<double>::quiet_NaN())
+      == std::unexpected {NaN});
+  }
+
+  SECTION("Integral to Float") {
+    STATIC_CHECK(try_numeric_cast<float>(INT64_MAX).has_value());
+  }
+}
+
+TEST_CASE("saturate_cast", "[numeric_cast][saturate]") {
+  SECTION("Integral to Integral") {
+    STATIC_CHECK(saturate_cast<int8_t>(100) == 100);
+    STATIC_CHECK(saturate_cast<int8_t>(1000) == 127);
+    STATIC_CHECK(saturate_cast<int8_t>(-1000) == -128);
+    STATIC_CHECK(saturate_cast<uint8_t>(-1) == 0);
+    STATIC_CHECK(saturate_cast<int32_t>(UINT64_MAX) == INT32_MAX);
+    STATIC_CHECK(noexcept(saturate_cast<int8_t>(1000)));
+  }
+
+  SECTION("Floating Point to Floating Point") {
+    constexpr auto Max = std::numeric_limits<float>::max();
+    STATIC_CHECK(saturate_cast<float>(1.5) == 1.5f);
+    STATIC_CHECK(saturate_cast<float>(static_cast<double>(Max) * 2) == Max);
+    STATIC_CHECK(
+      saturate_cast<float>(-std::numeric_limits<double>::infinity()) == -Max);
+    CHECK(std::isnan(saturate_cast<float>(NAN)));
+  }
+
+  SECTION("Float to Integral") {
+    constexpr auto Max = std::numeric_limits<int32_t>::max();
+    constexpr auto Lowest = std::numeric_limits<int32_t>::lowest();
+    STATIC_CHECK(saturate_cast<int32_t>(1.5) == 1);
+    STATIC_CHECK(saturate_cast<int32_t>(2147483647.5) == Max);
+    STATIC_CHECK(saturate_cast<int32_t>(1e20) == Max);
+    STATIC_CHECK(saturate_cast<int32_t>(-1e20) == Lowest);
+    // float(INT32_MAX) is 2^31, which is out of range
+    STATIC_CHECK(saturate_cast<int32_t>(static_cast<float>(Max)) == Max);
+    STATIC_CHECK(saturate_cast<uint8_t>(-0.5) == 0);
+    STATIC_CHECK(saturate_cast<uint8_t>(-1.0) == 0);
+
+    constexpr auto NaN = std::numeric_limits<double>::quiet_NaN();
+    STATIC_CHECK(saturate_cast<int32_t>(NaN) == 0);
+    STATIC_CHECK(saturate_cast<int32_t>(NaN, -1) == -1);
+  }
+
+  SECTION("ranges") {
+    const std::array in {
+      -1e300,
+      -1.0,
+      0.0,
+      0.5,
+      255.0,
+      1e20,
+      std::numeric_limits<double>::quiet_NaN()};
+    std::array<uint8_t, in.size()> out {};
+    saturate_cast<uint8_t>(in, out);
+    CHECK(out == std::array<uint8_t, in.size()> {0, 0, 0, 0, 255, 255, 0});
+    saturate_cast<uint8_t>(in, out, uint8_t {42});
+    CHECK(out.back() == 42);
+
+    std::array<float, in.size()> floats {};
+    saturate_cast<float>(in, floats);
+    CHECK(floats.front() == std::numeric_limits<float>::lowest());
+    CHECK(std::isnan(floats.back()));
+
+    std::array<uint8_t, 1> too_small {};
+    CHECK_THROWS_AS(
+      saturate_cast<uint8_t>(in, too_small), std::invalid_argument);
+  }
+}
+
+TEST_CASE("numeric_cast_range_error", "[numeric_cast][error]") {
+  SECTION("range") {
+    try {
+      std::ignore = numeric_cast<int8_t>(1000);
+      FAIL("Expected an exception");
+    } catch (const numeric_cast_range_error& e) {
+      CHECK(e.reason() == numeric_cast_error::TooHigh);
+      CHECK(std::get<std::intmax_t>(e.value()) == 1000);
+      CHECK(std::get<std::intmax_t>(e.lowest()) == -128);
+      CHECK(std::get<std::intmax_t>(e.max()) == 127);
+      CHECK(std::string_view {e.what()} == "Value 1000 out of range -128..127");
+    }
+  }
+
+  SECTION("floating point") {
+    try {
+      std::ignore = numeric_cast<uint8_t>(-1.5);
+      FAIL("Expected an exception");
+    } catch (const numeric_cast_range_error& e) {
+      CHECK(e.reason() == numeric_cast_error::TooLow);
+      CHECK(std::get<double>(e.value()) == -1.5);
+      CHECK(std::string_view {e.what()} == "Value -1.5 out of range 0..255");
+    }
+  }
+
+  SECTION("NaN") {
+    try {
+      std::ignore = numeric_cast<int>(std::numeric_limits<float>::quiet_NaN());
+      FAIL("Expected an exception");
+    } catch (const numeric_cast_range_error& e) {
+      CHECK(e.reason() == numeric_cast_error::NaN);
+      CHECK(
+        std::string_view {e.what()} == "Can't convert NaN to an integral type");
+    }
+  }
+
+  SECTION("element") {
+    const std::array in {1, 2, 300};
+    std::array<uint8_t, 3> out {};
+    try {
+      numeric_cast<uint8_t>(in, out);
+      FAIL("Expected an exception");
+    } catch (const numeric_cast_element_error& e) {
+      CHECK(e.index() == 2);
+      CHECK(e.reason() == numeric_cast_error::TooHigh);
+      CHECK(
+        std::string_view {e.what()}
+        == "Element 2: Value 300 out of range 0..255");
+    }
+  }
+}
+
+TEST_CASE("numeric_cast: rounding", "[numeric_cast][rounding]") {
+  SECTION("nearest_even") {
+    STATIC_CHECK(numeric_cast<int>(2.5, rounding::nearest_even) == 2);
+    STATIC_CHECK(numeric_cast<int>(3.5, rounding::nearest_even) == 4);
+    STATIC_CHECK(numeric_cast<int>(-2.5, rounding::nearest_even) == -2);
+    STATIC_CHECK(numeric_cast<int>(-3.5, rounding::nearest_even) == -4);
+    STATIC_CHECK(numeric_cast<int>(2.4f, rounding::nearest_even) == 2);
+    STATIC_CHECK(numeric_cast<int>(2.6f, rounding::nearest_even) == 3);
+    CHECK(numeric_cast<int>(2.5, rounding::nearest_even) == 2);
+    CHECK(numeric_cast<int>(-3.5f, rounding::nearest_even) == -4);
+  }
+
+  SECTION("nearest_away") {
+    STATIC_CHECK(numeric_cast<int>(2.5, rounding::nearest_away) == 3);
+    STATIC_CHECK(numeric_cast<int>(-2.5, rounding::nearest_away) == -3);
+    STATIC_CHECK(numeric_cast<int>(2.4, rounding::nearest_away) == 2);
+    // Naive `trunc(x + 0.5)` rounds this up, as the sum rounds to 1.0
+    STATIC_CHECK(
+      numeric_cast<int>(0.49999999999999994, rounding::nearest_away) == 0);
+    CHECK(numeric_cast<int>(0.49999999999999994, rounding::nearest_away) == 0);
+  }
+
+  SECTION("floor and ceil") {
+    STATIC_CHECK(numeric_cast<int>(1.5, rounding::floor) == 1);
+    STATIC_CHECK(numeric_cast<int>(-1.5, rounding::floor) == -2);
+    STATIC_CHECK(numeric_cast<int>(1.5, rounding::ceil) == 2);
+    STATIC_CHECK(numeric_cast<int>(-1.5, rounding::ceil) == -1);
+    STATIC_CHECK(numeric_cast<int>(-2.0, rounding::floor) == -2);
+    CHECK(numeric_cast<int>(-1.5, rounding::floor) == -2);
+    CHECK(numeric_cast<int>(-1.5, rounding::ceil) == -1);
+  }
+
+  SECTION("truncate") {
+    STATIC_CHECK(numeric_cast<int>(1.9, rounding::truncate) == 1);
+    STATIC_CHECK(numeric_cast<int>(-1.9, rounding::truncate) == -1);
+  }
+
+  SECTION("truncation at the lower bound matches the default") {
+    // (-1, 0)
+    STATIC_CHECK(numeric_cast<unsigned>(-0.5) == 0);
+    STATIC_CHECK(numeric_cast<unsigned>(-0.5, rounding::truncate) == 0);
+    STATIC_CHECK(numeric_cast<uint8_t>(-0.999f) == 0);
+    STATIC_CHECK(numeric_cast<uint8_t>(-0.999f, rounding::truncate) == 0);
+    STATIC_CHECK(
+      try_numeric_cast<unsigned>(-1.0)
+      == std::unexpected {numeric_cast_error::TooLow});
+    STATIC_CHECK(
+      try_numeric_cast<unsigned>(-1.0, rounding::truncate)
+      == std::unexpected {numeric_cast_error::TooLow});
+    CHECK_THROWS_AS(numeric_cast<unsigned>(-1.0), numeric_cast_range_error);
+    CHECK_THROWS_AS(
+      numeric_cast<unsigned>(-1.0, rounding::truncate),
+      numeric_cast_range_error);
+
+    // (lowest - 1, lowest)
+    STATIC_CHECK(numeric_cast<int8_t>(-128.5) == -128);
+    STATIC_CHECK(numeric_cast<int8_t>(-128.5, rounding::truncate) == -128);
+    STATIC_CHECK(numeric_cast<int8_t>(-128.999f) == -128);
+    STATIC_CHECK(numeric_cast<int8_t>(-128.999f, rounding::truncate) == -128);
+    STATIC_CHECK(
+      try_numeric_cast<int8_t>(-129.0)
+      == std::unexpected {numeric_cast_error::TooLow});
+    STATIC_CHECK(
+      try_numeric_cast<int8_t>(-129.0, rounding::truncate)
+      == std::unexpected {numeric_cast_error::TooLow});
+    CHECK_THROWS_AS(numeric_cast<int8_t>(-129.0), numeric_cast_range_error);
+    CHECK_THROWS_AS(
+      numeric_cast<int8_t>(-129.0, rounding::truncate),
+      numeric_cast_range_error);
+
+    // `lowest() - 1` is not representable as a double
+    constexpr auto Lowest = std::numeric_limits<int64_t>::lowest();
+    constexpr auto LowestD = static_cast<double>(Lowest);
+    STATIC_CHECK(numeric_cast<int64_t>(LowestD) == Lowest);
+    STATIC_CHECK(numeric_cast<int64_t>(LowestD, rounding::truncate) == Lowest);
+    const auto below
+      = std::nextafter(LowestD, -std::numeric_limits<double>::infinity());
+    CHECK_THROWS_AS(numeric_cast<int64_t>(below), numeric_cast_range_error);
+    CHECK_THROWS_AS(
+      numeric_cast<int64_t>(below, rounding::truncate),
+      numeric_cast_range_error);
+
+    const std::array in {-0.5, -0.999};
+    std::array<unsigned, in.size()> out {1, 1};
+    numeric_cast<unsigned>(in, out);
+    CHECK(out == std::array {0u, 0u});
+    out = {1, 1};
+    numeric_cast<unsigned>(in, out, rounding::truncate);
+    CHECK(out == std::array {0u, 0u});
+  }
+
+  SECTION("range checks use the rounded value") {
+    STATIC_CHECK(numeric_cast<int8_t>(127.4, rounding::nearest_even) == 127);
+    STATIC_CHECK(numeric_cast<int8_t>(-128.9, rounding::ceil) == -128);
+    CHECK_THROWS_AS(
+      numeric_cast<int8_t>(127.4, rounding::ceil), numeric_cast_range_error);
+    CHECK_THROWS_AS(
+      numeric_cast<int8_t>(-128.1, rounding::floor), numeric_cast_range_error);
+    CHECK_THROWS_AS(
+      numeric_cast<int8_t>(127.5, rounding::nearest_away),
+      numeric_cast_range_error);
+    CHECK_THROWS_AS(
+      numeric_cast<int>(
+        std::numeric_limits<double>::quiet_NaN(), rounding::floor),
+      numeric_cast_range_error);
+
+    STATIC_CHECK(
+      try_numeric_cast<uint8_t>(255.5, rounding::nearest_even)
+      == std::unexpected {numeric_cast_error::TooHigh});
+    STATIC_CHECK(
+      try_numeric_cast<uint8_t>(-0.5, rounding::nearest_even) == uint8_t {0});
+    STATIC_CHECK(
+      try_numeric_cast<uint8_t>(-0.5, rounding::floor)
+      == std::unexpected {numeric_cast_error::TooLow});
+  }
+
+  SECTION("large values") {
+    constexpr auto Large = 4503599627370497.0;// 2^52 + 1
+    STATIC_CHECK(
+      numeric_cast<int64_t>(Large, rounding::nearest_even)
+      == 4503599627370497);
+    CHECK(numeric_cast<int64_t>(Large, rounding::floor) == 4503599627370497);
+  }
+
+  SECTION("ranges") {
+    const std::array in {-1.5, -0.5, 0.5, 1.5, 2.5};
+    std::array<int, in.size()> out {};
+    numeric_cast<int>(in, out, rounding::nearest_even);
+    CHECK(out == std::array {-2, 0, 0, 2, 2});
+    numeric_cast<int>(in, out, rounding::nearest_away);
+    CHECK(out == std::array {-2, -1, 1, 2, 3});
+    numeric_cast<int>(in, out, rounding::floor);
+    CHECK(out == std::array {-2, -1, 0, 1, 2});
+    numeric_cast<int>(in, out, rounding::ceil);
+    CHECK(out == std::array {-1, 0, 1, 2, 3});
+
+    std::array<uint8_t, in.size()> bytes {};
+    try {
+      numeric_cast<uint8_t>(in, bytes, rounding::floor);
+      FAIL("Expected an exception");
+    } catch (const numeric_cast_element_error& e) {
+      CHECK(e.index() == 0);
+      CHECK(std::get<double>(e.value()) == -1.5);
+    }
+    // -0.5 rounds to 0, but -1.5 doesn't
+    try {
+      numeric_cast<uint8_t>(in, bytes, rounding::nearest_even);
+      FAIL("Expected an exception");
+    } catch (const numeric_cast_element_error& e) {
+      CHECK(e.index() == 0);
+    }
+  }
+}
@@ -0,0 +1,184 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/numeric_parse.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <variant>
+
+using namespace felly;
+
+TEST_CASE("try_numeric_parse", "[numeric_parse][try]") {
+  using enum numeric_parse_error;
+
+  SECTION("integral") {
+    CHECK(try_numeric_parse<int>("123") == 123);
+    CHECK(try_numeric_parse<int>("-123") == -123);
+    CHECK(try_numeric_parse<uint8_t>("255") == 255);
+    CHECK(try_numeric_parse<int8_t>("-128") == -128);
+  }
+
+  SECTION("integral out of range") {
+    CHECK(try_numeric_parse<uint8_t>("256").error() == TooHigh);
+    CHECK(try_numeric_parse<int8_t>("128").error() == TooHigh);
+    CHECK(try_numeric_parse<int8_t>("-129").error() == TooLow);
+    CHECK(
+      try_numeric_parse<int64_t>("99999999999999999999").error() == TooHigh);
+  }
+
+  SECTION("negative unsigned") {
+    CHECK(try_numeric_parse<uint8_t>("-1").error() == TooLow);
+    CHECK(try_numeric_parse<uint8_t>("-1000").error() == TooLow);
+    CHECK(try_numeric_parse<uint8_t>("-0") == 0);
+    CHECK(try_numeric_parse<uint8_t>("-").error() == Invalid);
+    CHECK(try_numeric_parse<uint8_t>("--1").error() == Invalid);
+    CHECK(try_numeric_parse<uint8_t>("-1x").error() == Invalid);
+  }
+
+  SECTION("invalid") {
+    CHECK(try_numeric_parse<int>("").error() == Invalid);
+    CHECK(try_numeric_parse<int>("abc").error() == Invalid);
+    CHECK(try_numeric_parse<int>("+1").error() == Invalid);
+    CHECK(try_numeric_parse<int>(" 1").error() == Invalid);
+    CHECK(try_numeric_parse<int>("1 ").error() == Invalid);
+    CHECK(try_numeric_parse<int>("1.5").error() == Invalid);
+    // Trailing characters take precedence over the range
+    CHECK(try_numeric_parse<uint8_t>("1000x").error() == Invalid);
+  }
+
+  SECTION("floating point") {
+    CHECK(try_numeric_parse<double>("1.5") == 1.5);
+    CHECK(try_numeric_parse<float>("-2.5e3") == -2500.0f);
+    CHECK(std::isinf(*try_numeric_parse<double>("inf")));
+    CHECK(std::isnan(*try_numeric_parse<double>("nan")));
+    CHECK(try_numeric_parse<double>("1.5x").error() == Invalid);
+  }
+
+  SECTION("floating point out of range") {
+    CHECK(try_numeric_parse<float>("1e39").error() == TooHigh);
+    CHECK(try_numeric_parse<float>("-1e39").error() == TooLow);
+    CHECK(try_numeric_parse<double>("1e400").error() == TooHigh);
+    CHECK(try_numeric_parse<double>("1e+400").error() == TooHigh);
+    CHECK(try_numeric_parse<double>("1e99999999999").error() == TooHigh);
+  }
+
+  SECTION("floating point too close to zero") {
+    const auto positive = try_numeric_parse<double>("1e-400");
+    REQUIRE(positive);
+    CHECK(*positive == 0);
+    CHECK(!std::signbit(*positive));
+
+    const auto negative = try_numeric_parse<double>("-0.0001e-400");
+    REQUIRE(negative);
+    CHECK(*negative == 0);
+    CHECK(std::signbit(*negative));
+
+    CHECK(try_numeric_parse<double>("1e-99999999999") == 0);
+  }
+}
+
+TEST_CASE("numeric_parse", "[numeric_parse]") {
+  SECTION("valid") {
+    CHECK(numeric_parse<int>("123") == 123);
+    CHECK(numeric_parse<double>("0.25") == 0.25);
+  }
+
+  SECTION("invalid") {
+    try {
+      std::ignore = numeric_parse<int>("abc");
+      FAIL("Expected an exception");
+    } catch (const numeric_parse_invalid_argument& e) {
+      CHECK(!e.field());
+      CHECK(std::string_view {e.what()} == "Can't parse 'abc' as a number");
+    }
+  }
+
+  SECTION("out of range") {
+    try {
+      std::ignore = numeric_parse<int8_t>("-1000");
+      FAIL("Expected an exception");
+    } catch (const numeric_parse_range_error& e) {
+      CHECK(e.reason() == numeric_parse_error::TooLow);
+      CHECK(std::get<std::intmax_t>(e.lowest()) == -128);
+      CHECK(std::get<std::intmax_t>(e.max()) == 127);
+      CHECK(
+        std::string_view {e.what()} == "Value '-1000' out of range -128..127");
+    }
+  }
+
+  SECTION("long text is truncated") {
+    try {
+      std::ignore = numeric_parse<int>(
+        "0123456789012345678901234567890123456789");
+      FAIL("Expected an exception");
+    } catch (const numeric_parse_range_error& e) {
+      CHECK(
+        std::string_view {e.what()}
+        == "Value '01234567890123456789012345678901...' out of range "
+           "-2147483648..2147483647");
+    }
+  }
+}
+
+TEST_CASE("numeric_parse: delimited", "[numeric_parse][delimited]") {
+  std::array<uint8_t, 4> out {};
+
+  SECTION("valid") {
+    const auto parsed = numeric_parse<uint8_t>("1,2,255", ',', out);
+    REQUIRE(parsed.size() == 3);
+    CHECK(parsed.data() == out.data());
+    CHECK(out == std::array<uint8_t, 4> {1, 2, 255, 0});
+  }
+
+  SECTION("full") {
+    CHECK(try_numeric_parse<uint8_t>("1 2 3 4", ' ', out)->size() == 4);
+  }
+
+  SECTION("empty") {
+    CHECK(numeric_parse<uint8_t>("", ',', out).empty());
+    CHECK(try_numeric_parse<uint8_t>(",", ',', out).error()
+          == numeric_parse_field_error {0, numeric_parse_error::Invalid});
+    CHECK(try_numeric_parse<uint8_t>("1,", ',', out).error()
+          == numeric_parse_field_error {1, numeric_parse_error::Invalid});
+  }
+
+  SECTION("too many fields") {
+    CHECK(try_numeric_parse<uint8_t>("1,2,3,4,5", ',', out).error()
+          == numeric_parse_field_error {4, numeric_parse_error::TooManyFields});
+    CHECK_THROWS_AS(
+      numeric_parse<uint8_t>("1,2,3,4,5", ',', out), std::invalid_argument);
+  }
+
+  SECTION("out of range") {
+    CHECK(try_numeric_parse<uint8_t>("1,256,3", ',', out).error()
+          == numeric_parse_field_error {1, numeric_parse_error::TooHigh});
+    try {
+      std::ignore = numeric_parse<uint8_t>("1,2,-3", ',', out);
+      FAIL("Expected an exception");
+    } catch (const numeric_parse_range_error& e) {
+      CHECK(e.field() == 2);
+      CHECK(e.reason() == numeric_parse_error::TooLow);
+      CHECK(
+        std::string_view {e.what()}
+        == "Field 2: Value '-3' out of range 0..255");
+    }
+  }
+
+  SECTION("invalid") {
+    try {
+      std::ignore = numeric_parse<uint8_t>("1;x", ';', out);
+      FAIL("Expected an exception");
+    } catch (const numeric_parse_invalid_argument& e) {
+      CHECK(e.field() == 1);
+      CHECK(
+        std::string_view {e.what()} == "Field 1: Can't parse 'x' as a number");
+    }
+  }
+}
@@ -0,0 +1,146 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/object_pool.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace felly::object_pool_types;
+
+namespace {
+
+struct Tracked {
+  static inline int live = 0;
+
+  explicit Tracked(const int value) : value(value) {
+    ++live;
+  }
+  ~Tracked() {
+    --live;
+  }
+
+  int value {};
+  std::string text {"test"};
+};
+
+struct Throwing {
+  Throwing() {
+    throw std::runtime_error("test");
+  }
+};
+
+struct Fresh {
+  int value {};
+};
+
+void create_fresh(Fresh** out) {
+  *out = object_pool<Fresh>::create(123);
+}
+
+// Destroyed after the pool's thread cache, if constructed first
+struct ThreadExit {
+  pooled_ptr<Tracked> object;
+  int* value {nullptr};
+
+  ~ThreadExit() {
+    object.reset();
+    *value = make_pooled<Tracked>(456)->value;
+  }
+};
+
+}// namespace
+
+TEST_CASE("object_pool") {
+  object_pool<Tracked>::trim();
+
+  SECTION("make_pooled") {
+    {
+      const auto p = make_pooled<Tracked>(123);
+      STATIC_CHECK(sizeof(p) == sizeof(Tracked*));
+      REQUIRE(p);
+      CHECK(p->value == 123);
+      CHECK(p->text == "test");
+      CHECK(Tracked::live == 1);
+    }
+    CHECK(Tracked::live == 0);
+  }
+
+  SECTION("storage is reused") {
+    const Tracked* address = nullptr;
+    {
+      const auto p = make_pooled<Tracked>(1);
+      address = p.get();
+    }
+    const auto p = make_pooled<Tracked>(2);
+    CHECK(p.get() == address);
+    CHECK(p->value == 2);
+  }
+
+  SECTION("many objects") {
+    std::vector<pooled_ptr<Tracked>> objects;
+    for (int i = 0; i < 1000; ++i) {
+      objects.push_back(make_pooled<Tracked>(i));
+    }
+    CHECK(Tracked::live == 1000);
+    objects.clear();
+    CHECK(Tracked::live == 0);
+    for (int i = 0; i < 1000; ++i) {
+      objects.push_back(make_pooled<Tracked>(i));
+    }
+    CHECK(objects.back()->value == 999);
+  }
+
+  SECTION("destroyed on another thread") {
+    std::vector<pooled_ptr<Tracked>> objects;
+    for (int i = 0; i < 200; ++i) {
+      objects.push_back(make_pooled<Tracked>(i));
+    }
+    std::thread([&objects] { objects.clear(); }).join();
+    CHECK(Tracked::live == 0);
+
+    // The other thread's cache was returned to the shared list on exit
+    for (int i = 0; i < 200; ++i) {
+      objects.push_back(make_pooled<Tracked>(i));
+    }
+    CHECK(Tracked::live == 200);
+  }
+
+  SECTION("used after the thread cache is destroyed") {
+    int value {};
+    std::thread([&value] {
+      thread_local ThreadExit exit;
+      exit.value = &value;
+      exit.object = make_pooled<Tracked>(123);
+    }).join();
+    CHECK(value == 456);
+    CHECK(Tracked::live == 0);
+  }
+
+  SECTION("constructor throws") {
+    CHECK_THROWS_AS(make_pooled<Throwing>(), std::runtime_error);
+    CHECK_THROWS_AS(make_pooled<Throwing>(), std::runtime_error);
+  }
+
+  SECTION("std::out_ptr") {
+    pooled_ptr<Fresh> p;
+    create_fresh(std::out_ptr(p));
+    REQUIRE(p);
+    CHECK(p->value == 123);
+  }
+
+  SECTION("std::inout_ptr") {
+    auto p = make_pooled<Fresh>(1);
+    const auto reset = [](Fresh** inout) {
+      object_pool<Fresh>::destroy(*inout);
+      *inout = object_pool<Fresh>::create(2);
+    };
+    reset(std::inout_ptr(p));
+    REQUIRE(p);
+    CHECK(p->value == 2);
+  }
+}
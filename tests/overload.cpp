@@ -3,6 +3,10 @@
 
 #include <felly/overload.hpp>
 #include <format>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <variant>
 
 #include <catch2/catch_test_macros.hpp>
@@ -23,4 +27,124 @@ TEST_CASE("variant visit") {
 
   CHECK(std::visit(visitor, myInt) == "visit int 123");
   CHECK(std::visit(visitor, myFloat) == "visit float 1.23");
-}
\ No newline at end of file
+}
+TEST_CASE("felly::match") {
+  using MyType = std::variant<int, float, std::string>;
+
+  constexpr auto visitor = felly::overload {
+    [](const int) { return 1; },
+    [](const float) { return 2; },
+    [](const std::string&) { return 3; },
+  };
+
+  CHECK(felly::match(MyType {123}, visitor) == 1);
+  CHECK(felly::match(MyType {1.23f}, visitor) == 2);
+  const MyType str {"foo"};
+  CHECK(felly::match(str, visitor) == 3);
+
+  SECTION("constexpr") {
+    constexpr std::variant<int, float> v {1.23f};
+    STATIC_CHECK(
+      felly::match(
+        v,
+        felly::overload {
+          [](int) { return 1; },
+          [](float) { return 2; },
+        })
+      == 2);
+  }
+
+  SECTION("value categories") {
+    MyType v {std::string {"foo"}};
+    felly::match(
+      v,
+      felly::overload {
+        [](auto&) {},
+        [](std::string& s) { s = "bar"; },
+      });
+    CHECK(std::get<std::string>(v) == "bar");
+
+    const auto moved = felly::match(
+      std::move(v),
+      felly::overload {
+        [](auto&&) { return std::string {}; },
+        [](std::string&& s) { return std::move(s); },
+      });
+    CHECK(moved == "bar");
+  }
+
+  SECTION("returning references") {
+    std::variant<int, float> v {123};
+    int forInt = 0;
+    int forFloat = 0;
+    decltype(auto) ref = felly::match(
+      v,
+      felly::overload {
+        [&](int) -> int& { return forInt; },
+        [&](float) -> int& { return forFloat; },
+      });
+    STATIC_CHECK(std::same_as<decltype(ref), int&>);
+    CHECK(&ref == &forInt);
+  }
+}
+
+TEST_CASE("felly::visit") {
+  SECTION("large variants") {
+    using Large = std::variant<
+      std::integral_constant<int, 0>,
+      std::integral_constant<int, 1>,
+      std::integral_constant<int, 2>,
+      std::integral_constant<int, 3>,
+      std::integral_constant<int, 4>,
+      std::integral_constant<int, 5>,
+      std::integral_constant<int, 6>,
+      std::integral_constant<int, 7>,
+      std::integral_constant<int, 8>,
+      std::integral_constant<int, 9>,
+      std::integral_constant<int, 10>,
+      std::integral_constant<int, 11>,
+      std::integral_constant<int, 12>,
+      std::integral_constant<int, 13>,
+      std::integral_constant<int, 14>,
+      std::integral_constant<int, 15>,
+      std::integral_constant<int, 16>,
+      std::integral_constant<int, 17>>;
+    const auto value = [](auto x) { return decltype(x)::value; };
+    CHECK(felly::visit(value, Large {std::in_place_index<3>}) == 3);
+    CHECK(felly::visit(value, Large {std::in_place_index<17>}) == 17);
+  }
+
+  SECTION("multiple variants") {
+    using A = std::variant<int, std::string>;
+    using B = std::variant<float, char>;
+    const auto visitor = felly::overload {
+      [](int, float) { return std::string {"int, float"}; },
+      [](int, char) { return std::string {"int, char"}; },
+      [](const std::string& s, float) { return s + ", float"; },
+      [](const std::string& s, char c) { return s + ", " + c; },
+    };
+    CHECK(felly::visit(visitor, A {1}, B {1.0f}) == "int, float");
+    CHECK(felly::visit(visitor, A {1}, B {'c'}) == "int, char");
+    CHECK(felly::visit(visitor, A {"str"}, B {1.0f}) == "str, float");
+    CHECK(felly::visit(visitor, A {"str"}, B {'c'}) == "str, c");
+    const std::variant<bool> C {true};
+    CHECK(
+      felly::visit(
+        [](auto, auto, bool b) { return b; }, A {1}, B {'c'}, C));
+  }
+
+  SECTION("valueless by exception") {
+    struct Throwing {
+      Throwing() = default;
+      Throwing(const Throwing&) {
+        throw std::runtime_error("test");
+      }
+    };
+    std::variant<int, Throwing> v {123};
+    const Throwing throwing;
+    CHECK_THROWS_AS(v = throwing, std::runtime_error);
+    REQUIRE(v.valueless_by_exception());
+    CHECK_THROWS_AS(
+      felly::match(v, [](auto&&) {}), std::bad_variant_access);
+  }
+}
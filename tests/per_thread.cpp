@@ -0,0 +1,156 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/hardware_interference_size.hpp>
+#include <felly/per_thread.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using felly::per_thread;
+
+namespace {
+
+constexpr auto sum = [](const int acc, const auto& value) {
+  return acc + static_cast<int>(value);
+};
+
+constexpr auto count = [](const int acc, const auto&) { return acc + 1; };
+
+// Destroyed after the thread's `per_thread` cache if that is created later
+struct ThreadExit {
+  per_thread<int>* counter {nullptr};
+  int* address {nullptr};
+
+  ~ThreadExit() {
+    ++counter->local();
+    ++counter->local();
+    // Not a new slot for each call
+    *address = (&counter->local() == &counter->local());
+  }
+};
+
+}// namespace
+
+TEST_CASE("per_thread") {
+  SECTION("local") {
+    per_thread<int> counter;
+    CHECK(counter.reduce(0, sum) == 0);
+    int& local = counter.local();
+    CHECK(&counter.local() == &local);
+    ++local;
+    ++counter.local();
+    CHECK(counter.reduce(0, sum) == 2);
+  }
+
+  SECTION("alignment") {
+    per_thread<int> counter;
+    const auto address = reinterpret_cast<std::uintptr_t>(&counter.local());
+    CHECK(address % felly::hardware_destructive_interference_size == 0);
+  }
+
+  SECTION("multiple instances") {
+    per_thread<int> a;
+    per_thread<int> b;
+    ++a.local();
+    b.local() += 2;
+    ++a.local();
+    CHECK(&a.local() != &b.local());
+    CHECK(a.reduce(0, sum) == 2);
+    CHECK(b.reduce(0, sum) == 2);
+  }
+
+  SECTION("many interleaved instances") {
+    // More than fit in the thread's recently-used slots
+    constexpr int Count = 20;
+    std::vector<std::unique_ptr<per_thread<int>>> counters;
+    std::vector<int*> addresses;
+    for (int i = 0; i < Count; ++i) {
+      counters.push_back(std::make_unique<per_thread<int>>());
+      addresses.push_back(&counters.back()->local());
+    }
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < Count; ++j) {
+        auto& local = counters[j]->local();
+        CHECK(&local == addresses[j]);
+        local += j;
+      }
+    }
+    for (int i = 0; i < Count; ++i) {
+      CHECK(counters[i]->reduce(0, sum) == 3 * i);
+      CHECK(counters[i]->reduce(0, count) == 1);
+    }
+  }
+
+  SECTION("used after the thread cache is destroyed") {
+    per_thread<int> counter;
+    per_thread<int> other;
+    int sameSlot {0};
+    std::thread([&] {
+      thread_local ThreadExit exit;
+      exit.counter = &counter;
+      exit.address = &sameSlot;
+      ++counter.local();
+      // So that the destructor does not use `counter`'s most recent slot
+      std::ignore = other.local();
+    }).join();
+    CHECK(sameSlot == 1);
+    CHECK(counter.reduce(0, sum) == 3);
+  }
+
+  SECTION("threads") {
+    constexpr int ThreadCount = 8;
+    constexpr int PerThread = 1000;
+
+    per_thread<std::atomic<int>> counter;
+    std::vector<int*> addresses(ThreadCount);
+    {
+      std::vector<std::jthread> threads;
+      for (int i = 0; i < ThreadCount; ++i) {
+        threads.emplace_back([&counter] {
+          for (int j = 0; j < PerThread; ++j) {
+            counter.local().fetch_add(1, std::memory_order_relaxed);
+          }
+        });
+      }
+      // Concurrently with the writers
+      const auto partial = counter.reduce(
+        0, [](const int acc, const std::atomic<int>& value) {
+          return acc + value.load(std::memory_order_relaxed);
+        });
+      CHECK(partial <= ThreadCount * PerThread);
+    }
+    // Values from exited threads are kept
+    CHECK(counter.reduce(0, sum) == ThreadCount * PerThread);
+  }
+
+  SECTION("slots are reused") {
+    per_thread<int> counter;
+    std::jthread {[&] { ++counter.local(); }}.join();
+    std::jthread {[&] { ++counter.local(); }}.join();
+    CHECK(counter.reduce(0, count) == 1);
+    CHECK(counter.reduce(0, sum) == 2);
+  }
+
+  SECTION("destroyed before thread exits") {
+    auto counter = std::make_unique<per_thread<int>>();
+    std::atomic_flag registered;
+    std::atomic_flag destroyed;
+    std::jthread thread {[&] {
+      ++counter->local();
+      registered.test_and_set();
+      registered.notify_all();
+      destroyed.wait(false);
+    }};
+    registered.wait(false);
+    CHECK(counter->reduce(0, sum) == 1);
+    counter.reset();
+    destroyed.test_and_set();
+    destroyed.notify_all();
+  }
+}
@@ -0,0 +1,170 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/retain_ptr.hpp>
+#include <felly/unique_any.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+struct RefCounted {
+  int refs {1};
+  int value {};
+};
+
+void add_ref(RefCounted* p) {
+  ++p->refs;
+}
+
+void release(RefCounted* p) {
+  --p->refs;
+}
+
+using test_type = felly::retain_ptr<RefCounted, &add_ref, &release>;
+using const_test_type = felly::retain_ptr<const RefCounted, &add_ref, &release>;
+
+}// namespace
+
+TEST_CASE("retain_ptr") {
+  using felly::adopt_ref;
+  using felly::retain_ref;
+
+  RefCounted object {};
+
+  SECTION("static checks") {
+    STATIC_CHECK(sizeof(test_type) == sizeof(void*));
+    STATIC_CHECK(std::copyable<test_type>);
+    STATIC_CHECK(std::totally_ordered<test_type>);
+  }
+
+  SECTION("empty") {
+    test_type p;
+    CHECK_FALSE(p);
+    CHECK(p == nullptr);
+    CHECK(p.get() == nullptr);
+    CHECK_THROWS_AS(*p, std::logic_error);
+    CHECK(test_type {nullptr, retain_ref} == nullptr);
+  }
+
+  SECTION("adopt") {
+    {
+      test_type p {&object, adopt_ref};
+      CHECK(p);
+      CHECK(p.get() == &object);
+      CHECK(object.refs == 1);
+    }
+    CHECK(object.refs == 0);
+  }
+
+  SECTION("retain") {
+    {
+      test_type p {&object, retain_ref};
+      CHECK(object.refs == 2);
+      CHECK(p->refs == 2);
+    }
+    CHECK(object.refs == 1);
+  }
+
+  SECTION("copy and move") {
+    test_type a {&object, adopt_ref};
+    {
+      auto b = a;
+      CHECK(object.refs == 2);
+      CHECK(a == b);
+
+      auto c = std::move(b);
+      CHECK(object.refs == 2);
+      CHECK_FALSE(b);
+      CHECK(c.get() == &object);
+    }
+    CHECK(object.refs == 1);
+
+    // Not released before being added
+    a = *std::addressof(a);
+    CHECK(object.refs == 1);
+
+    RefCounted other {};
+    test_type d {&other, adopt_ref};
+    d = a;
+    CHECK(other.refs == 0);
+    CHECK(object.refs == 2);
+  }
+
+  SECTION("reset") {
+    test_type p {&object, retain_ref};
+    CHECK(object.refs == 2);
+    p.reset();
+    CHECK(object.refs == 1);
+    p.reset(&object, retain_ref);
+    CHECK(object.refs == 2);
+    p.reset(&object, adopt_ref);
+    CHECK(object.refs == 1);
+  }
+
+  SECTION("disown") {
+    test_type p {&object, retain_ref};
+    CHECK(p.disown() == &object);
+    CHECK_FALSE(p);
+    CHECK(object.refs == 2);
+  }
+
+  SECTION("const") {
+    {
+      const_test_type p {&object, retain_ref};
+      STATIC_CHECK(std::same_as<decltype(p.get()), const RefCounted*>);
+      CHECK(object.refs == 2);
+    }
+    CHECK(object.refs == 1);
+  }
+
+  SECTION("from unique_any") {
+    using unique_type = felly::unique_any<RefCounted* const, &release>;
+    STATIC_CHECK_FALSE(std::convertible_to<unique_type&&, test_type>);
+    STATIC_CHECK_FALSE(std::constructible_from<test_type, unique_type&&>);
+    felly::unique_any<RefCounted* const, &release> unique {&object};
+    {
+      test_type p {std::move(unique), adopt_ref};
+      CHECK_FALSE(unique);
+      CHECK(p.get() == &object);
+      CHECK(object.refs == 1);
+    }
+    CHECK(object.refs == 0);
+  }
+
+  SECTION("predicate") {
+    using predicate_test_type = felly::retain_ptr<
+      RefCounted,
+      &add_ref,
+      &release,
+      [](RefCounted* p) { return std::bit_cast<intptr_t>(p) != -1; }>;
+    const auto invalid = std::bit_cast<RefCounted*>(intptr_t {-1});
+    CHECK_FALSE(predicate_test_type {invalid, retain_ref});
+    CHECK(predicate_test_type {&object, retain_ref});
+    CHECK(object.refs == 1);
+  }
+
+  SECTION("std::out_ptr") {
+    test_type p;
+    [&](RefCounted** out) { *out = &object; }(std::out_ptr(p, adopt_ref));
+    CHECK(p.get() == &object);
+    CHECK(object.refs == 1);
+  }
+
+  SECTION("std::inout_ptr") {
+    RefCounted other {};
+    test_type p {&object, adopt_ref};
+    [&](RefCounted** inout) {
+      release(*inout);
+      *inout = &other;
+    }(std::inout_ptr(p, adopt_ref));
+    CHECK(p.get() == &other);
+    CHECK(object.refs == 0);
+    CHECK(other.refs == 1);
+  }
+}
@@ -4,6 +4,10 @@
 #include <catch2/catch_test_macros.hpp>
 #include <felly/scope_exit.hpp>
 
+#include <array>
+#include <memory>
+#include <vector>
+
 namespace {
 struct test_exception {};
 }// namespace
@@ -181,4 +185,95 @@ TEST_CASE("scope_exit released then moved") {
     CHECK(count == 0);
   }
   CHECK(count == 0);
-}
\ No newline at end of file
+}
+TEST_CASE("scope_exit_stack") {
+  std::vector<int> order;
+
+  SECTION("LIFO") {
+    {
+      felly::scope_exit_stack<4> stack;
+      CHECK(stack.empty());
+      for (int i = 0; i < 3; ++i) {
+        stack.push([&order, i] { order.push_back(i); });
+      }
+      CHECK(stack.size() == 3);
+      CHECK(order.empty());
+    }
+    CHECK(order == std::vector {2, 1, 0});
+  }
+
+  SECTION("beyond inline capacity") {
+    {
+      felly::scope_exit_stack<2> stack;
+      for (int i = 0; i < 7; ++i) {
+        stack.push([&order, i] { order.push_back(i); });
+      }
+      CHECK(stack.size() == 7);
+    }
+    CHECK(order == std::vector {6, 5, 4, 3, 2, 1, 0});
+  }
+
+  SECTION("release") {
+    const auto counter = std::make_shared<int>(0);
+    {
+      felly::scope_exit_stack<2> stack;
+      for (int i = 0; i < 3; ++i) {
+        stack.push([&order, counter] { order.push_back(++*counter); });
+      }
+      CHECK(counter.use_count() == 4);
+      stack.release();
+      CHECK(stack.empty());
+      // Callbacks are destroyed by `release()`
+      CHECK(counter.use_count() == 1);
+
+      stack.push([&order] { order.push_back(123); });
+    }
+    CHECK(order == std::vector {123});
+  }
+
+  SECTION("callback size") {
+    using stack_type = felly::scope_exit_stack<1, 8>;
+    std::array<char, 8> fits {};
+    std::array<char, 9> too_big {};
+    STATIC_CHECK(
+      requires(stack_type s) { s.push([fits] { (void)fits; }); });
+    STATIC_CHECK_FALSE(
+      requires(stack_type s) { s.push([too_big] { (void)too_big; }); });
+  }
+}
+
+TEST_CASE("scope_fail_stack") {
+  int count = 0;
+  {
+    felly::scope_fail_stack<1> stack;
+    stack.push([&] { ++count; });
+  }
+  CHECK(count == 0);
+
+  try {
+    felly::scope_fail_stack<1> stack;
+    stack.push([&] { ++count; });
+    stack.push([&] { ++count; });
+    throw test_exception {};
+  } catch (const test_exception&) {
+  }
+  CHECK(count == 2);
+}
+
+TEST_CASE("scope_success_stack") {
+  int count = 0;
+  {
+    felly::scope_success_stack<1> stack;
+    stack.push([&] { ++count; });
+    stack.push([&] { ++count; });
+  }
+  CHECK(count == 2);
+
+  try {
+    felly::scope_success_stack<1> stack;
+    stack.push([&] { ++count; });
+    throw test_exception {};
+  } catch (const test_exception&) {
+  }
+  CHECK(count == 2);
+}
@@ -0,0 +1,127 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/seqlocked.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace felly::seqlocked_types;
+
+namespace {
+struct Pair {
+  int64_t a {};
+  int64_t b {};
+};
+
+// Not a multiple of the word size
+struct Unaligned {
+  char data[13] {};
+};
+
+struct NotDefaultConstructible {
+  NotDefaultConstructible() = delete;
+  constexpr NotDefaultConstructible(const int v) : value(v) {}
+  int value;
+};
+}// namespace
+
+TEST_CASE("seqlocked") {
+  SECTION("load and store") {
+    seqlocked<Pair> value {1, 2};
+    CHECK(value.load().a == 1);
+    CHECK(value.load().b == 2);
+    value.store({3, 4});
+    CHECK(value.load().a == 3);
+    CHECK(value.load().b == 4);
+  }
+
+  SECTION("default-initialized") {
+    seqlocked<Pair> value;
+    CHECK(value.load().a == 0);
+    CHECK(value.load().b == 0);
+  }
+
+  SECTION("sizes that aren't a multiple of the word size") {
+    seqlocked<Unaligned> value;
+    value.store({"hello world!"});
+    CHECK(std::string_view {value.load().data} == "hello world!");
+  }
+
+  SECTION("not default-constructible") {
+    seqlocked<NotDefaultConstructible> value {123};
+    CHECK(value.load().value == 123);
+  }
+
+  SECTION("write lock") {
+    seqlocked<Pair> value {1, 2};
+    {
+      auto lock = value.lock();
+      CHECK(lock);
+      CHECK(lock->a == 1);
+      lock->a = 3;
+      // Not published until unlocked
+      CHECK(value.load().a == 1);
+    }
+    CHECK(value.load().a == 3);
+    CHECK(value.load().b == 2);
+
+    auto lock = value.lock();
+    lock->b = 4;
+    lock.unlock();
+    CHECK_FALSE(lock);
+    CHECK_THROWS(lock.unlock());
+    CHECK(value.load().b == 4);
+  }
+
+  SECTION("moved write lock") {
+    seqlocked<Pair> value {1, 2};
+    {
+      auto lock = value.lock();
+      lock->a = 3;
+      auto moved = std::move(lock);
+      CHECK_FALSE(lock);
+      CHECK(moved);
+      CHECK(moved->a == 3);
+    }
+    CHECK(value.load().a == 3);
+  }
+
+  SECTION("writers are serialized") {
+    seqlocked<Pair> value;
+    auto lock = value.lock();
+    std::jthread other([&] { value.lock()->a = 123; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    lock->a = 456;
+    lock.unlock();
+    other.join();
+    CHECK(value.load().a == 123);
+  }
+
+  SECTION("readers never see partial writes") {
+    seqlocked<Pair> value;
+    std::atomic<bool> done {false};
+    std::atomic<int> torn {0};
+
+    std::vector<std::jthread> readers;
+    for (int i = 0; i < 4; ++i) {
+      readers.emplace_back([&] {
+        while (!done) {
+          const auto v = value.load();
+          if (v.a != -v.b) {
+            ++torn;
+          }
+        }
+      });
+    }
+
+    for (int64_t i = 0; i < 100000; ++i) {
+      value.store({i, -i});
+    }
+    done = true;
+    readers.clear();
+    CHECK(torn == 0);
+  }
+}
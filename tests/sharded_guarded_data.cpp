@@ -0,0 +1,116 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/sharded_guarded_data.hpp>
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace felly::guarded_data_types;
+using namespace felly::sharded_guarded_data_types;
+
+TEST_CASE("aligned_guarded_data") {
+  using test_type = aligned_guarded_data<int>;
+  constexpr auto CacheLine = felly::hardware_destructive_interference_size;
+  STATIC_CHECK(alignof(test_type) == CacheLine);
+  STATIC_CHECK(sizeof(test_type) % CacheLine == 0);
+
+  test_type guarded(123);
+  CHECK(*guarded.lock() == 123);
+  CHECK(*guarded.try_lock() == 123);
+
+  SECTION("array elements do not share cache lines") {
+    test_type array[2] {};
+    const auto a = reinterpret_cast<std::uintptr_t>(&array[0]);
+    const auto b = reinterpret_cast<std::uintptr_t>(&array[1]);
+    CHECK(b - a >= CacheLine);
+  }
+
+  SECTION("lock_all") {
+    test_type other(456);
+    auto [a, b] = lock_all(guarded, other);
+    CHECK(*a == 123);
+    CHECK(*b == 456);
+  }
+}
+
+TEST_CASE("sharded_guarded_data") {
+  using test_type = sharded_guarded_data<std::map<int, std::string>, 4>;
+  STATIC_CHECK(test_type::shard_count == 4);
+
+  SECTION("keys are stable across locks") {
+    test_type sharded;
+    sharded.lock(123)->emplace(123, "foo");
+    sharded.lock(456)->emplace(456, "bar");
+
+    CHECK(sharded.lock(123)->at(123) == "foo");
+    CHECK(sharded.lock(456)->at(456) == "bar");
+    CHECK(sharded.shard_index(123) == sharded.shard_index(123));
+    CHECK(sharded.shard(sharded.shard_index(123)).lock()->contains(123));
+  }
+
+  SECTION("shards are locked independently") {
+    sharded_guarded_data<int, 2, decltype([](const int key) {
+      return static_cast<std::size_t>(key);
+    })>
+      sharded(0);
+    CHECK(sharded.shard_index(0) == 0);
+    CHECK(sharded.shard_index(1) == 1);
+
+    auto locked = sharded.lock(0);
+    std::thread([&] {
+      CHECK_FALSE(sharded.shard(0).try_lock());
+      CHECK(sharded.shard(1).try_lock());
+    }).join();
+  }
+
+  SECTION("each shard is constructed from the arguments") {
+    const sharded_guarded_data<std::string, 3> sharded("foo");
+    std::size_t count = 0;
+    sharded.for_each_shard([&](const std::string& shard) {
+      CHECK(shard == "foo");
+      ++count;
+    });
+    CHECK(count == 3);
+  }
+
+  SECTION("for_each_shard") {
+    test_type sharded;
+    for (int i = 0; i < 100; ++i) {
+      sharded.lock(i)->emplace(i, std::to_string(i));
+    }
+
+    std::size_t total = 0;
+    sharded.for_each_shard(
+      [&](std::map<int, std::string>& shard) { total += shard.size(); });
+    CHECK(total == 100);
+
+    sharded.for_each_shard([](auto& shard) { shard.clear(); });
+    total = 0;
+    std::as_const(sharded).for_each_shard(
+      [&](const auto& shard) { total += shard.size(); });
+    CHECK(total == 0);
+  }
+
+  SECTION("concurrent access") {
+    sharded_guarded_data<int, 8> sharded(0);
+    constexpr int ThreadCount = 8;
+    constexpr int Iterations = 1000;
+    {
+      std::vector<std::jthread> threads;
+      for (int i = 0; i < ThreadCount; ++i) {
+        threads.emplace_back([&, i] {
+          for (int j = 0; j < Iterations; ++j) {
+            ++*sharded.lock(i + j);
+          }
+        });
+      }
+    }
+    int total = 0;
+    sharded.for_each_shard([&](const int count) { total += count; });
+    CHECK(total == ThreadCount * Iterations);
+  }
+}
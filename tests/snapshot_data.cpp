@@ -0,0 +1,131 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/snapshot_data.hpp>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace felly::snapshot_data_types;
+
+namespace {
+struct Tracked {
+  static inline int live_count = 0;
+
+  Tracked() { ++live_count; }
+  explicit Tracked(const int v) : value(v) { ++live_count; }
+  Tracked(const Tracked& other) : value(other.value) { ++live_count; }
+  ~Tracked() { --live_count; }
+
+  int value {};
+};
+}// namespace
+
+TEST_CASE("snapshot_data") {
+  SECTION("read and update") {
+    snapshot_data<std::map<int, std::string>> data;
+    CHECK(data.read()->empty());
+
+    data.update([](auto& map) { map.emplace(1, "foo"); });
+    CHECK(data.read()->at(1) == "foo");
+
+    const auto ret = data.update([](auto& map) {
+      map.emplace(2, "bar");
+      return map.size();
+    });
+    CHECK(ret == 2);
+    CHECK(data.read()->size() == 2);
+  }
+
+  SECTION("static checks") {
+    using snapshot_type = decltype(std::declval<snapshot_data<int>&>().read());
+    STATIC_CHECK(std::same_as<snapshot_type, snapshot<int>>);
+    STATIC_CHECK(
+      std::same_as<decltype(std::declval<snapshot_type>().get()), const int&>);
+    STATIC_CHECK(std::copyable<snapshot_type>);
+  }
+
+  SECTION("old snapshots are unaffected by updates") {
+    snapshot_data<int> data {1};
+    const auto before = data.read();
+    data.update([](int& v) { v = 2; });
+    const auto after = data.read();
+
+    CHECK(*before == 1);
+    CHECK(*after == 2);
+    CHECK_FALSE(before == after);
+    CHECK(after == data.read());
+  }
+
+  SECTION("store") {
+    snapshot_data<std::string> data {"foo"};
+    data.store("bar");
+    CHECK(*data.read() == "bar");
+  }
+
+  SECTION("failed updates are not published") {
+    snapshot_data<int> data {1};
+    CHECK_THROWS(data.update([](int& v) {
+      v = 2;
+      throw std::runtime_error("test");
+    }));
+    CHECK(*data.read() == 1);
+  }
+
+  SECTION("old versions are freed after the last reader") {
+    Tracked::live_count = 0;
+    {
+      snapshot_data<Tracked> data {1};
+      CHECK(Tracked::live_count == 1);
+      {
+        const auto old = data.read();
+        data.update([](Tracked& v) { v.value = 2; });
+        CHECK(Tracked::live_count == 2);
+        CHECK(old->value == 1);
+      }
+      CHECK(Tracked::live_count == 1);
+      CHECK(data.read()->value == 2);
+    }
+    CHECK(Tracked::live_count == 0);
+  }
+
+  SECTION("concurrent readers and writers") {
+    // Invariant: the vector is always [0, 1, ..., n]
+    snapshot_data<std::vector<int>> data;
+    std::atomic<bool> done {false};
+    std::atomic<int> broken {0};
+    {
+      std::vector<std::jthread> threads;
+      for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+          while (!done) {
+            const auto snapshot = data.read();
+            for (std::size_t j = 0; j < snapshot->size(); ++j) {
+              if ((*snapshot)[j] != static_cast<int>(j)) {
+                ++broken;
+              }
+            }
+          }
+        });
+      }
+      for (int i = 0; i < 2; ++i) {
+        threads.emplace_back([&] {
+          for (int j = 0; j < 500; ++j) {
+            data.update(
+              [](auto& v) { v.push_back(static_cast<int>(v.size())); });
+          }
+        });
+      }
+      while (data.read()->size() < 1000) {
+        std::this_thread::yield();
+      }
+      done = true;
+    }
+    CHECK(broken == 0);
+    CHECK(data.read()->size() == 1000);
+  }
+}
@@ -0,0 +1,151 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+#include <felly/trivially_relocatable.hpp>
+#include <felly/unique_any.hpp>
+#include <felly/unique_ptr.hpp>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using felly::is_trivially_relocatable_v;
+
+namespace {
+
+struct SelfPointer {
+  SelfPointer() = default;
+  SelfPointer(SelfPointer&&) noexcept {}
+  SelfPointer& operator=(SelfPointer&&) noexcept {
+    return *this;
+  }
+  ~SelfPointer() {}
+
+  SelfPointer* self {this};
+};
+
+// Not trivially copyable, but does not depend on its own address
+struct OptIn {
+  static inline std::vector<int> destroyed;
+
+  explicit OptIn(const int value) : value(value) {}
+  OptIn(OptIn&& other) noexcept : value(std::exchange(other.value, -1)) {}
+  OptIn& operator=(OptIn&& other) noexcept {
+    value = std::exchange(other.value, -1);
+    return *this;
+  }
+  ~OptIn() {
+    destroyed.push_back(value);
+  }
+
+  int value {};
+};
+
+struct Counted {
+  static inline int live = 0;
+  int value {};
+};
+
+void destroy_counted(Counted* p) {
+  --Counted::live;
+  delete p;
+}
+
+void destroy_self_pointer(SelfPointer&) {}
+void destroy_opt_in(OptIn&) {}
+
+using counted_ptr = felly::unique_ptr<Counted, &destroy_counted>;
+
+}// namespace
+
+template <>
+struct felly::is_trivially_relocatable<OptIn> : std::true_type {};
+
+TEST_CASE("is_trivially_relocatable") {
+  STATIC_CHECK(is_trivially_relocatable_v<int>);
+  STATIC_CHECK(is_trivially_relocatable_v<int*>);
+  STATIC_CHECK(is_trivially_relocatable_v<const int>);
+  STATIC_CHECK(is_trivially_relocatable_v<std::optional<int>>);
+  STATIC_CHECK_FALSE(is_trivially_relocatable_v<SelfPointer>);
+  STATIC_CHECK_FALSE(is_trivially_relocatable_v<std::optional<SelfPointer>>);
+
+  STATIC_CHECK(is_trivially_relocatable_v<OptIn>);
+  STATIC_CHECK(is_trivially_relocatable_v<std::optional<OptIn>>);
+
+  SECTION("unique_any") {
+    STATIC_CHECK(is_trivially_relocatable_v<counted_ptr>);
+    using counted_any = felly::unique_any<Counted*, &destroy_counted>;
+    STATIC_CHECK(is_trivially_relocatable_v<counted_any>);
+    STATIC_CHECK(
+      is_trivially_relocatable_v<felly::unique_any<const int, [](int) {}>>);
+    STATIC_CHECK(
+      is_trivially_relocatable_v<felly::unique_any<OptIn, &destroy_opt_in>>);
+    STATIC_CHECK_FALSE(is_trivially_relocatable_v<
+                       felly::unique_any<SelfPointer, &destroy_self_pointer>>);
+  }
+}
+
+TEST_CASE("relocate") {
+  SECTION("trivially relocatable") {
+    {
+      alignas(counted_ptr) std::byte from[sizeof(counted_ptr) * 3] {};
+      alignas(counted_ptr) std::byte to[sizeof(counted_ptr) * 3] {};
+      const auto first = reinterpret_cast<counted_ptr*>(from);
+      const auto result = reinterpret_cast<counted_ptr*>(to);
+      for (int i = 0; i < 3; ++i) {
+        std::construct_at(first + i, new Counted {i});
+        ++Counted::live;
+      }
+
+      CHECK(felly::relocate(first, first + 3, result) == result + 3);
+      CHECK(Counted::live == 3);
+      for (int i = 0; i < 3; ++i) {
+        CHECK(result[i]->value == i);
+      }
+      std::destroy(result, result + 3);
+    }
+    CHECK(Counted::live == 0);
+  }
+
+  SECTION("overlapping") {
+    std::array<int, 5> values {0, 1, 2, 3, 4};
+    CHECK(
+      felly::relocate(values.data() + 2, values.data() + 5, values.data() + 1)
+      == values.data() + 4);
+    CHECK(values[0] == 0);
+    CHECK(values[1] == 2);
+    CHECK(values[2] == 3);
+    CHECK(values[3] == 4);
+  }
+
+  SECTION("opt-in") {
+    OptIn::destroyed.clear();
+    alignas(OptIn) std::byte from[sizeof(OptIn)] {};
+    alignas(OptIn) std::byte to[sizeof(OptIn)] {};
+    const auto first = std::construct_at(reinterpret_cast<OptIn*>(from), 123);
+    const auto result = reinterpret_cast<OptIn*>(to);
+    felly::relocate(first, first + 1, result);
+    // Neither the move constructor nor the destructor were called
+    CHECK(OptIn::destroyed.empty());
+    CHECK(result->value == 123);
+    std::destroy_at(result);
+    CHECK(OptIn::destroyed == std::vector {123});
+  }
+
+  SECTION("not trivially relocatable") {
+    std::array<SelfPointer, 2> from {};
+    alignas(SelfPointer) std::byte to[sizeof(SelfPointer) * 2] {};
+    const auto result = reinterpret_cast<SelfPointer*>(to);
+    felly::relocate(from.data(), from.data() + 2, result);
+    CHECK(result[0].self == &result[0]);
+    CHECK(result[1].self == &result[1]);
+    std::destroy(result, result + 2);
+    // `from`'s elements were destroyed by `relocate()`; recreate them so that
+    // they can be destroyed again at the end of the scope
+    std::construct_at(&from[0]);
+    std::construct_at(&from[1]);
+  }
+}
@@ -106,14 +106,21 @@ using unique_fd_like_inline =
     return v >= 0;
   }>;
 
+using unique_fd_like_sentinel = felly::
+  unique_any_with_sentinel<const int, &Tracker::track, -1, [](const int v) {
+    return v >= 0;
+  }>;
+
 static_assert(sizeof(unique_fd_like_with_traits) == sizeof(int));
 static_assert(sizeof(unique_fd_like_inline) == sizeof(std::optional<int>));
+static_assert(sizeof(unique_fd_like_sentinel) == sizeof(int));
 
 TEMPLATE_TEST_CASE(
   "unique_any - basic functionality",
   "",
   unique_fd_like_with_traits,
-  unique_fd_like_inline) {
+  unique_fd_like_inline,
+  unique_fd_like_sentinel) {
   SECTION("static checks") {
     STATIC_CHECK(std::same_as<const int, typename TestType::value_type>);
     STATIC_CHECK(std::swappable<TestType>);
@@ -486,6 +493,34 @@ TEST_CASE("unique_any - const pointers") {
   }
 }
 
+TEST_CASE("unique_any - sentinel storage") {
+  using test_type = felly::unique_any_with_sentinel<
+    int64_t,
+    [](const int64_t v) { Tracker::track(static_cast<int>(v)); },
+    int64_t {-1}>;
+
+  SECTION("size") { STATIC_CHECK(sizeof(test_type) == sizeof(int64_t)); }
+
+  SECTION("only the sentinel is invalid") {
+    Tracker::reset();
+    CHECK_FALSE(test_type {-1});
+    CHECK_FALSE(test_type {std::nullopt});
+    CHECK(test_type {-2});
+    CHECK(test_type {0});
+    CHECK(Tracker::call_count == 2);
+  }
+
+  SECTION("destroy writes the sentinel") {
+    Tracker::reset();
+    test_type v {123};
+    v.reset();
+    CHECK_FALSE(v);
+    CHECK(v == test_type {std::nullopt});
+    CHECK(Tracker::call_count == 1);
+    CHECK(Tracker::last_value == 123);
+  }
+}
+
 TEST_CASE("unique_any - optional-backed storage") {
   struct value_type : felly::non_copyable {
     constexpr value_type() = default;
@@ -0,0 +1,162 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "felly/unique_any_vector.hpp"
+
+using namespace felly::unique_any_types;
+
+namespace {
+
+struct Tracker {
+  static inline std::vector<int> destroyed;
+  static inline std::size_t batch_count = 0;
+
+  static void reset() {
+    destroyed.clear();
+    batch_count = 0;
+  }
+
+  static void destroy(const int value) {
+    destroyed.push_back(value);
+  }
+
+  static void destroy_batch(const std::span<int> values) {
+    ++batch_count;
+    destroyed.insert(destroyed.end(), values.begin(), values.end());
+  }
+
+  static void destroy_batch_c(const std::size_t count, const int* values) {
+    destroy_batch({const_cast<int*>(values), count});
+  }
+};
+
+constexpr auto is_valid = [](const int value) { return value >= 0; };
+
+using unique_value
+  = unique_any<const int, &Tracker::destroy, is_valid>;
+using value_vector
+  = unique_any_vector<const int, &Tracker::destroy, is_valid>;
+using batch_vector = unique_any_vector<
+  const int,
+  &Tracker::destroy,
+  is_valid,
+  &Tracker::destroy_batch>;
+using c_batch_vector = unique_any_vector<
+  const int,
+  &Tracker::destroy,
+  is_valid,
+  &Tracker::destroy_batch_c>;
+
+static_assert(!value_vector::has_batch_deleter);
+static_assert(batch_vector::has_batch_deleter);
+
+}// namespace
+
+TEST_CASE("unique_any_vector") {
+  Tracker::reset();
+
+  SECTION("per-element destruction") {
+    {
+      value_vector values;
+      values.adopt(1);
+      values.push_back(unique_value {2});
+      CHECK(values.size() == 2);
+      CHECK(values[0] == 1);
+      CHECK(values[1] == 2);
+      CHECK(Tracker::destroyed.empty());
+    }
+    CHECK(Tracker::destroyed == std::vector {1, 2});
+  }
+
+  SECTION("batch destruction") {
+    {
+      batch_vector values;
+      for (int i = 0; i < 100; ++i) {
+        values.adopt(i);
+      }
+    }
+    CHECK(Tracker::batch_count == 1);
+    CHECK(Tracker::destroyed.size() == 100);
+    CHECK(Tracker::destroyed.back() == 99);
+  }
+
+  SECTION("size and pointer batch destruction") {
+    c_batch_vector values;
+    values.adopt(1);
+    values.adopt(2);
+    values.clear();
+    CHECK(values.empty());
+    CHECK(Tracker::batch_count == 1);
+    CHECK(Tracker::destroyed == std::vector {1, 2});
+
+    // Empty vectors don't call the batch deleter
+    values.clear();
+    CHECK(Tracker::batch_count == 1);
+  }
+
+  SECTION("invalid values") {
+    value_vector values;
+    CHECK_THROWS_AS(values.adopt(-1), std::invalid_argument);
+    CHECK_THROWS_AS(
+      values.push_back(unique_value {std::nullopt}), std::logic_error);
+    CHECK(values.empty());
+  }
+
+  SECTION("values are contiguous") {
+    batch_vector values;
+    values.adopt(1);
+    values.adopt(2);
+    const auto span = values.values();
+    REQUIRE(span.size() == 2);
+    CHECK(span.data() == &values[0]);
+    CHECK(std::vector(values.begin(), values.end()) == std::vector {1, 2});
+  }
+
+  SECTION("pop_back") {
+    value_vector values;
+    values.adopt(1);
+    values.adopt(2);
+    {
+      const auto last = values.pop_back();
+      CHECK(last == 2);
+      CHECK(values.size() == 1);
+      CHECK(Tracker::destroyed.empty());
+    }
+    CHECK(Tracker::destroyed == std::vector {2});
+    std::ignore = values.pop_back();
+    CHECK_THROWS_AS(values.pop_back(), std::logic_error);
+  }
+
+  SECTION("disown") {
+    batch_vector values;
+    values.adopt(1);
+    values.adopt(2);
+    CHECK(values.disown() == std::vector {1, 2});
+    CHECK(values.empty());
+    values.clear();
+    CHECK(Tracker::batch_count == 0);
+  }
+
+  SECTION("move") {
+    batch_vector a;
+    a.adopt(1);
+    batch_vector b {std::move(a)};
+    CHECK(a.empty());
+    CHECK(b.size() == 1);
+
+    batch_vector c;
+    c.adopt(2);
+    c = std::move(b);
+    // c's previous value was destroyed
+    CHECK(Tracker::destroyed == std::vector {2});
+    CHECK(c.size() == 1);
+    CHECK(c[0] == 1);
+  }
+}
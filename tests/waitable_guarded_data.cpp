@@ -0,0 +1,105 @@
+// Copyright 2026 Fred Emmott <fred@fredemmott.com>
+// SPDX-License-Identifier: MIT
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <felly/adaptive_mutex.hpp>
+#include <felly/waitable_guarded_data.hpp>
+
+#include <deque>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace felly::guarded_data_types;
+using namespace felly::waitable_guarded_data_types;
+
+namespace {
+template <class T>
+concept notifiable = requires(T& v) { v.notify_one(); };
+
+template <class T>
+concept waitable = requires(T& v, bool (*pred)(const int&)) { v.wait(pred); };
+}// namespace
+
+TEST_CASE("waitable_guarded_data static checks") {
+  STATIC_CHECK_FALSE(notifiable<guarded_data<int>>);
+  STATIC_CHECK_FALSE(waitable<unique_guarded_data_lock<int>>);
+  STATIC_CHECK(notifiable<waitable_guarded_data<int>>);
+  STATIC_CHECK(
+    waitable<unique_guarded_data_lock<int, waitable_mutex<std::mutex>>>);
+}
+
+TEMPLATE_TEST_CASE(
+  "waitable_guarded_data",
+  "",
+  std::mutex,
+  felly::adaptive_mutex) {
+  using test_type = waitable_guarded_data<std::deque<int>, TestType>;
+
+  SECTION("predicate already true") {
+    test_type queue {1, 2, 3};
+    auto lock = queue.lock();
+    lock.wait([](const auto& q) { return !q.empty(); });
+    CHECK(lock->size() == 3);
+    CHECK(lock.wait_for(0ms, [](const auto& q) { return !q.empty(); }));
+    CHECK(lock.wait_until(
+      std::chrono::steady_clock::now(),
+      [](const auto& q) { return !q.empty(); }));
+  }
+
+  SECTION("timeout") {
+    test_type queue;
+    auto lock = queue.lock();
+    CHECK_FALSE(lock.wait_for(1ms, [](const auto& q) { return !q.empty(); }));
+    CHECK_FALSE(lock.wait_until(
+      std::chrono::steady_clock::now() + 1ms,
+      [](const auto& q) { return !q.empty(); }));
+    // Still locked
+    std::thread([&] { CHECK_FALSE(queue.try_lock()); }).join();
+  }
+
+  SECTION("producer/consumer") {
+    test_type queue;
+    constexpr int Count = 1000;
+    std::jthread producer([&] {
+      for (int i = 0; i < Count; ++i) {
+        queue.lock()->push_back(i);
+        queue.notify_one();
+      }
+    });
+
+    for (int i = 0; i < Count; ++i) {
+      auto lock = queue.lock();
+      lock.wait([](const auto& q) { return !q.empty(); });
+      CHECK(lock->front() == i);
+      lock->pop_front();
+    }
+  }
+
+  SECTION("notify_all") {
+    test_type queue;
+    constexpr int ThreadCount = 4;
+    std::atomic<int> woken {0};
+    {
+      std::vector<std::jthread> threads;
+      for (int i = 0; i < ThreadCount; ++i) {
+        threads.emplace_back([&] {
+          auto lock = queue.lock();
+          lock.wait([](const auto& q) { return !q.empty(); });
+          ++woken;
+        });
+      }
+      queue.lock()->push_back(1);
+      queue.notify_all();
+    }
+    CHECK(woken == ThreadCount);
+  }
+
+  SECTION("unlocked") {
+    test_type queue;
+    auto lock = queue.lock();
+    lock.unlock();
+    CHECK_THROWS(lock.wait([](const auto&) { return true; }));
+  }
+}